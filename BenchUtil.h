@@ -0,0 +1,83 @@
+#pragma once
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QtGlobal>
+
+// 基准程序（TickerBench / NetshParseBench）共用：命令行选项和一行一个 JSON 对象的输出
+// 选项都是 --name value 或 --name 开关；输出每行自带本次参数，两次运行的结果直接逐行对比
+
+class BenchArgs {
+public:
+    explicit BenchArgs(const QStringList& args) : m_args(args) {}
+
+    // --name 出现过
+    bool flag(const char* name) const {
+        return find(name) > 0;
+    }
+
+    // --name value；没有或后面没跟值时返回 def
+    QString value(const char* name, const QString& def = QString()) const {
+        const int i = find(name);
+        return (i > 0 && i + 1 < m_args.size()) ? m_args.at(i + 1) : def;
+    }
+
+    // 整数值，不小于 minValue；解析不了时返回 def
+    int intValue(const char* name, int def, int minValue) const {
+        bool ok = false;
+        const int v = value(name).toInt(&ok);
+        return ok ? qMax(minValue, v) : def;
+    }
+
+private:
+    // 最后一次出现的位置（跳过程序名），没有返回 -1
+    int find(const char* name) const {
+        for (int i = m_args.size() - 1; i > 0; --i) {
+            if (m_args.at(i) == QLatin1String(name)) return i;
+        }
+        return -1;
+    }
+
+    QStringList m_args;
+};
+
+// 逐个字段拼一行 JSON（字段按添加顺序输出）
+class BenchJson {
+public:
+    BenchJson& field(const char* key, const QString& s) { return raw(key, quoted(s)); }
+    BenchJson& field(const char* key, const char* s) { return field(key, QString::fromUtf8(s)); }
+    BenchJson& field(const char* key, bool b) { return raw(key, b ? QStringLiteral("true") : QStringLiteral("false")); }
+    BenchJson& field(const char* key, int v) { return raw(key, QString::number(v)); }
+    BenchJson& field(const char* key, qint64 v) { return raw(key, QString::number(v)); }
+    BenchJson& field(const char* key, quint64 v) { return raw(key, QString::number(v)); }
+    BenchJson& field(const char* key, double v, int decimals = 1) { return raw(key, QString::number(v, 'f', decimals)); }
+
+    // 已经是 JSON 的值（嵌套对象）
+    BenchJson& raw(const char* key, const QString& json) {
+        if (!m_body.isEmpty()) m_body += QStringLiteral(",");
+        m_body += quoted(QString::fromUtf8(key));
+        m_body += QStringLiteral(":");
+        m_body += json;
+        return *this;
+    }
+
+    QString toString() const { return QStringLiteral("{") + m_body + QStringLiteral("}"); }
+
+    // 输出到 stdout 一行，立即刷新（长时间的基准边跑边能看到）
+    void print() const {
+        QTextStream out(stdout);
+        out << toString() << QStringLiteral("\n");
+        out.flush();
+    }
+
+    static QString quoted(QString s) {
+        s.replace(QStringLiteral("\\"), QStringLiteral("\\\\"));
+        s.replace(QStringLiteral("\""), QStringLiteral("\\\""));
+        s.replace(QStringLiteral("\n"), QStringLiteral("\\n"));
+        s.replace(QStringLiteral("\r"), QStringLiteral("\\r"));
+        return QStringLiteral("\"") + s + QStringLiteral("\"");
+    }
+
+private:
+    QString m_body;
+};
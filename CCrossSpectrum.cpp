@@ -0,0 +1,222 @@
+#include <string.h>
+#include "CCrossSpectrum.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CROSS_SSE2 1
+#endif
+
+/*累加分块大小（频点数）：一块内所有通道的频谱约 C*2KB，留在 L1/L2 里反复使用*/
+#define CROSS_BLOCK 256
+
+CCrossSpectrum::CCrossSpectrum()
+{
+	n_Channels = 0;
+	n_Power = 0;
+	n_Count = 0;
+	n_Bins = 0;
+	n_Stride = 0;
+	n_Pairs = 0;
+	n_Threads = 1;
+	n_Frames = 0;
+}
+CCrossSpectrum::~CCrossSpectrum()
+{
+}
+void CCrossSpectrum::Setup(int channels, int nPower, int threads)
+{
+	if (channels < 1) channels = 1;
+	if (nPower < 1) nPower = 1;
+	p_Plan = CFftPlan::Get(nPower);
+	n_Channels = channels;
+	n_Power = p_Plan->GetPower();
+	n_Count = p_Plan->GetCount();
+	n_Bins = n_Count / 2 + 1;
+	n_Stride = (n_Bins + 3) & ~3;
+	n_Pairs = channels * (channels + 1) / 2;
+	n_Threads = FftThreadCount(threads);
+
+	v_XRe.assign((size_t)n_Channels * n_Stride, 0.0f);
+	v_XIm.assign((size_t)n_Channels * n_Stride, 0.0f);
+	v_SRe.assign((size_t)n_Pairs * n_Stride, 0.0f);
+	v_SIm.assign((size_t)n_Pairs * n_Stride, 0.0f);
+	v_Work.resize((size_t)n_Threads * 3 * n_Count);
+	n_Frames = 0;
+}
+void CCrossSpectrum::Reset()
+{
+	n_Frames = 0;
+	/*未 Setup：没有累加区*/
+	if (v_SRe.empty()) return;
+	memset(&v_SRe[0], 0, sizeof(float) * v_SRe.size());
+	memset(&v_SIm[0], 0, sizeof(float) * v_SIm.size());
+}
+int CCrossSpectrum::PairIndex(int i, int j) const
+{
+	if (i > j)
+	{
+		int t = i;
+		i = j;
+		j = t;
+	}
+	/*上三角按行展开：第 i 行之前共有 i*C - i*(i-1)/2 个元素*/
+	return i * n_Channels - i * (i - 1) / 2 + (j - i);
+}
+/*两路实信号打包成一次复数 FFT：z = a + j*b
+Xa[k] = (Z[k] + conj(Z[N-k]))/2，Xb[k] = (Z[k] - conj(Z[N-k]))/(2j)
+b 为 NULL 时只取 a*/
+void CCrossSpectrum::TransformPair(const float *a, const float *b, int ca, int cb, int worker)
+{
+	int n, k;
+	TCOMPLEX *pBuf = &v_Work[(size_t)worker * 3 * n_Count];
+	TCOMPLEX *pWork = pBuf + n_Count;
+
+	for (n = 0; n < n_Count; n++)
+	{
+		pBuf[n].re = a[n];
+		pBuf[n].im = (b != NULL) ? b[n] : 0.0f;
+	}
+	p_Plan->Forward(pBuf, pBuf, pWork);
+
+	float *aRe = &v_XRe[(size_t)ca * n_Stride];
+	float *aIm = &v_XIm[(size_t)ca * n_Stride];
+	if (b == NULL)
+	{
+		for (k = 0; k < n_Bins; k++)
+		{
+			aRe[k] = pBuf[k].re;
+			aIm[k] = pBuf[k].im;
+		}
+		return;
+	}
+	float *bRe = &v_XRe[(size_t)cb * n_Stride];
+	float *bIm = &v_XIm[(size_t)cb * n_Stride];
+	for (k = 0; k < n_Bins; k++)
+	{
+		const TCOMPLEX zk = pBuf[k];
+		const TCOMPLEX zn = pBuf[(n_Count - k) & (n_Count - 1)];
+		/*zc = conj(Z[N-k])*/
+		const float cre = zn.re;
+		const float cim = -zn.im;
+		aRe[k] = 0.5f * (zk.re + cre);
+		aIm[k] = 0.5f * (zk.im + cim);
+		bRe[k] = 0.5f * (zk.im - cim);
+		bIm[k] = -0.5f * (zk.re - cre);
+	}
+}
+/*频点 [k0,k1) 的上三角互谱累加：S_ij += Xi*conj(Xj)
+re += ar*br + ai*bi，im += ai*br - ar*bi*/
+void CCrossSpectrum::AccumulateBins(int k0, int k1)
+{
+	int i, j, k;
+	for (i = 0; i < n_Channels; i++)
+	{
+		const float *ar = &v_XRe[(size_t)i * n_Stride];
+		const float *ai = &v_XIm[(size_t)i * n_Stride];
+		for (j = i; j < n_Channels; j++)
+		{
+			const float *br = &v_XRe[(size_t)j * n_Stride];
+			const float *bi = &v_XIm[(size_t)j * n_Stride];
+			const int pair = PairIndex(i, j);
+			float *sr = &v_SRe[(size_t)pair * n_Stride];
+			float *si = &v_SIm[(size_t)pair * n_Stride];
+			k = k0;
+#ifdef CROSS_SSE2
+			/*k0、k1 都是 4 的倍数（或 k1==stride），整段可按 4 路处理*/
+			for (; k + 4 <= k1; k += 4)
+			{
+				const __m128 vAr = _mm_loadu_ps(ar + k);
+				const __m128 vAi = _mm_loadu_ps(ai + k);
+				const __m128 vBr = _mm_loadu_ps(br + k);
+				const __m128 vBi = _mm_loadu_ps(bi + k);
+				__m128 vRe = _mm_add_ps(_mm_mul_ps(vAr, vBr), _mm_mul_ps(vAi, vBi));
+				__m128 vIm = _mm_sub_ps(_mm_mul_ps(vAi, vBr), _mm_mul_ps(vAr, vBi));
+				_mm_storeu_ps(sr + k, _mm_add_ps(_mm_loadu_ps(sr + k), vRe));
+				_mm_storeu_ps(si + k, _mm_add_ps(_mm_loadu_ps(si + k), vIm));
+			}
+#endif
+			for (; k < k1; k++)
+			{
+				sr[k] += ar[k] * br[k] + ai[k] * bi[k];
+				si[k] += ai[k] * br[k] - ar[k] * bi[k];
+			}
+		}
+	}
+}
+void CCrossSpectrum::AddFrame(const float * const *data)
+{
+	if (n_Channels <= 0) return;
+
+	/*1) 各通道变换：两两打包，按“通道对”分给各线程*/
+	const int jobs = (n_Channels + 1) / 2;
+	FftParallelFor(jobs, n_Threads, [this, data](int b, int e, int worker) {
+		for (int t = b; t < e; t++)
+		{
+			const int ca = 2 * t;
+			const int cb = ca + 1;
+			if (cb < n_Channels)
+				TransformPair(data[ca], data[cb], ca, cb, worker);
+			else
+				TransformPair(data[ca], NULL, ca, ca, worker);
+		}
+	});
+
+	/*2) 互谱累加：按频点块分给各线程，块之间不共享输出*/
+	const int blocks = (n_Stride + CROSS_BLOCK - 1) / CROSS_BLOCK;
+	FftParallelFor(blocks, n_Threads, [this](int b, int e, int) {
+		for (int t = b; t < e; t++)
+		{
+			const int k0 = t * CROSS_BLOCK;
+			int k1 = k0 + CROSS_BLOCK;
+			if (k1 > n_Stride) k1 = n_Stride;
+			AccumulateBins(k0, k1);
+		}
+	});
+	n_Frames++;
+}
+void CCrossSpectrum::GetCross(int i, int j, TCOMPLEX *out) const
+{
+	int k;
+	if (v_SRe.empty()) return;
+	const int pair = PairIndex(i, j);
+	const float *sr = &v_SRe[(size_t)pair * n_Stride];
+	const float *si = &v_SIm[(size_t)pair * n_Stride];
+	const float scale = (n_Frames > 0) ? 1.0f / n_Frames : 0.0f;
+	const float sign = (i > j) ? -1.0f : 1.0f;
+	for (k = 0; k < n_Bins; k++)
+	{
+		out[k].re = sr[k] * scale;
+		out[k].im = sign * si[k] * scale;
+	}
+}
+void CCrossSpectrum::GetCoherence(int i, int j, float *out) const
+{
+	int k;
+	if (v_SRe.empty()) return;
+	const float *sr = &v_SRe[(size_t)PairIndex(i, j) * n_Stride];
+	const float *si = &v_SIm[(size_t)PairIndex(i, j) * n_Stride];
+	const float *pi = &v_SRe[(size_t)PairIndex(i, i) * n_Stride];
+	const float *pj = &v_SRe[(size_t)PairIndex(j, j) * n_Stride];
+	for (k = 0; k < n_Bins; k++)
+	{
+		const float den = pi[k] * pj[k];
+		out[k] = (den > 0.0f) ? (sr[k] * sr[k] + si[k] * si[k]) / den : 0.0f;
+	}
+}
+void CCrossSpectrum::GetMatrix(int bin, TCOMPLEX *out) const
+{
+	int i, j;
+	const float scale = (n_Frames > 0) ? 1.0f / n_Frames : 0.0f;
+	for (i = 0; i < n_Channels; i++)
+	{
+		for (j = i; j < n_Channels; j++)
+		{
+			const size_t idx = (size_t)PairIndex(i, j) * n_Stride + bin;
+			const float re = v_SRe[idx] * scale;
+			const float im = v_SIm[idx] * scale;
+			out[i * n_Channels + j].re = re;
+			out[i * n_Channels + j].im = im;
+			out[j * n_Channels + i].re = re;
+			out[j * n_Channels + i].im = -im;
+		}
+	}
+}
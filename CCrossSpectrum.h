@@ -0,0 +1,64 @@
+/***********
+类名：CCrossSpectrum.h
+描述：多通道互谱密度矩阵 / 相干函数（Welch 平均，不加窗，窗函数由调用方预先乘好）
+      每帧所有通道共用一个 CFftPlan 做变换（实信号两两打包成一次复数 FFT），
+      按频点累加 Hermitian 互谱矩阵 S_ij[k] += X_i[k]*conj(X_j[k])，只存上三角 i<=j。
+      累加按频点分块，块内 SSE2 向量化，各块分给多个线程。
+************/
+#ifndef _CROSS_SPECTRUM_H_
+#define _CROSS_SPECTRUM_H_
+#include <memory>
+#include <vector>
+#include "CFftPlan.h"
+
+class CCrossSpectrum
+{
+public:
+	CCrossSpectrum();
+	~CCrossSpectrum();
+
+	// channels：通道数；nPower：每帧 2^nPower 点；threads<=0 取 CPU 核数
+	void Setup(int channels, int nPower, int threads = 0);
+	// 清空累加结果（保留配置）；Setup 之前调用 Reset / AddFrame / GetXxx 什么都不做
+	void Reset();
+
+	// 加入一帧：data[c] 指向第 c 通道的 2^nPower 个实数采样
+	void AddFrame(const float * const *data);
+
+	int GetChannels() const { return n_Channels; }
+	int GetBinCount() const { return n_Bins; }            // N/2+1（单边谱）
+	int GetPairCount() const { return n_Pairs; }          // C*(C+1)/2
+	int GetFrameCount() const { return n_Frames; }
+	// 上三角 (i,j) 的存储序号（i<=j）
+	int PairIndex(int i, int j) const;
+
+	// 平均互谱 S_ij（i>j 时按 Hermitian 取共轭），out 长度 >= GetBinCount()
+	void GetCross(int i, int j, TCOMPLEX *out) const;
+	// 幅值平方相干 |S_ij|^2 / (S_ii*S_jj)，out 长度 >= GetBinCount()
+	void GetCoherence(int i, int j, float *out) const;
+	// 某一频点的完整 C*C 矩阵（行主序，已平均）
+	void GetMatrix(int bin, TCOMPLEX *out) const;
+
+protected:
+
+private:
+	int n_Channels;
+	int n_Power;
+	int n_Count;
+	int n_Bins;
+	int n_Stride;                    // 每行按 4 对齐后的频点数
+	int n_Pairs;
+	int n_Threads;
+	int n_Frames;
+	std::shared_ptr<const CFftPlan> p_Plan;
+
+	std::vector<float> v_XRe;        // 当前帧各通道频谱 [c*stride + k]
+	std::vector<float> v_XIm;
+	std::vector<float> v_SRe;        // 互谱累加 [pair*stride + k]
+	std::vector<float> v_SIm;
+	std::vector<TCOMPLEX> v_Work;    // 每线程：N 点缓冲 + 2N 点 FFT 工作区
+
+	void TransformPair(const float *a, const float *b, int ca, int cb, int worker);
+	void AccumulateBins(int k0, int k1);
+};
+#endif
@@ -0,0 +1,313 @@
+#include <math.h>
+#include "CDctAlg.h"
+
+CDctAlg::CDctAlg()
+{
+	n_Rot23Power = -1;
+	n_Rot4Power = -1;
+}
+CDctAlg::~CDctAlg()
+{
+}
+TCOMPLEX *CDctAlg::Buffer(int len)
+{
+	if ((int)v_Buf.size() < len) v_Buf.resize(len);
+	return &v_Buf[0];
+}
+float *CDctAlg::Temp(int len)
+{
+	if ((int)v_Tmp.size() < len) v_Tmp.resize(len);
+	return &v_Tmp[0];
+}
+bool CDctAlg::PowerOk(int nPower, int extra)
+{
+	return nPower >= 0 && nPower + extra <= CFftPlan::MAX_POWER;
+}
+/*exp(-j*PI*k/2N)，k<N；长度不变时直接复用*/
+const TCOMPLEX *CDctAlg::Rotation23(int nPower)
+{
+	int k;
+	if (n_Rot23Power != nPower)
+	{
+		const int N = 1 << nPower;
+		v_Rot23.resize(N);
+		for (k = 0; k < N; k++)
+		{
+			const double a = -PI * k / (2.0 * N);
+			v_Rot23[k].re = (float)cos(a);
+			v_Rot23[k].im = (float)sin(a);
+		}
+		n_Rot23Power = nPower;
+	}
+	return &v_Rot23[0];
+}
+/*前旋转 exp(-j*PI*(4n+1)/4N)、后旋转 exp(-j*PI*n/N)，n<N/2*/
+void CDctAlg::Rotation4(int nPower, const TCOMPLEX **pPre, const TCOMPLEX **pPost)
+{
+	int n;
+	if (n_Rot4Power != nPower)
+	{
+		const int N = 1 << nPower;
+		const int H = N / 2;
+		v_Rot4Pre.resize(H);
+		v_Rot4Post.resize(H);
+		for (n = 0; n < H; n++)
+		{
+			const double a = -PI * (4.0 * n + 1) / (4.0 * N);
+			const double b = -PI * n / (double)N;
+			v_Rot4Pre[n].re = (float)cos(a);
+			v_Rot4Pre[n].im = (float)sin(a);
+			v_Rot4Post[n].re = (float)cos(b);
+			v_Rot4Post[n].im = (float)sin(b);
+		}
+		n_Rot4Power = nPower;
+	}
+	*pPre = &v_Rot4Pre[0];
+	*pPost = &v_Rot4Post[0];
+}
+/*DCT-I：偶延拓到 2N 点，y[k] = Re(U[k])/2*/
+bool CDctAlg::DCT1(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 1)) return false;
+	std::shared_ptr<const CFftPlan> plan = CFftPlan::Get(nPower + 1);
+	const int N = 1 << nPower;
+	TCOMPLEX *pBuf = Buffer(2 * N);
+	for (n = 0; n <= N; n++)
+	{
+		pBuf[n].re = in[n];
+		pBuf[n].im = 0.0f;
+	}
+	for (n = 1; n < N; n++)
+	{
+		pBuf[2 * N - n].re = in[n];
+		pBuf[2 * N - n].im = 0.0f;
+	}
+	plan->Forward(pBuf, pBuf);
+	for (n = 0; n <= N; n++)
+		out[n] = 0.5f * pBuf[n].re;
+	return true;
+}
+/*DCT-II（Makhoul）：v[n]=x[2n]，v[N-1-n]=x[2n+1]；y[k] = Re(exp(-j*PI*k/2N) * V[k])*/
+bool CDctAlg::DCT2(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	std::shared_ptr<const CFftPlan> plan = CFftPlan::Get(nPower);
+	const int N = 1 << nPower;
+	const TCOMPLEX *pRot = Rotation23(nPower);
+	TCOMPLEX *pBuf = Buffer(N);
+	for (n = 0; n < N / 2; n++)
+	{
+		pBuf[n].re = in[2 * n];
+		pBuf[n].im = 0.0f;
+		pBuf[N - 1 - n].re = in[2 * n + 1];
+		pBuf[N - 1 - n].im = 0.0f;
+	}
+	if (N == 1)
+	{
+		pBuf[0].re = in[0];
+		pBuf[0].im = 0.0f;
+	}
+	plan->Forward(pBuf, pBuf);
+	for (n = 0; n < N; n++)
+		out[n] = pBuf[n].re * pRot[n].re - pBuf[n].im * pRot[n].im;
+	return true;
+}
+/*DCT-III：DCT-II 的逆过程
+conj(V[k]) = exp(-j*PI*k/2N) * (X[k] + j*X[N-k])，v = Re(FFT(conj V))/N，再按 Makhoul 还原顺序，乘 N/2*/
+bool CDctAlg::DCT3(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	std::shared_ptr<const CFftPlan> plan = CFftPlan::Get(nPower);
+	const int N = 1 << nPower;
+	const TCOMPLEX *pRot = Rotation23(nPower);
+	TCOMPLEX *pBuf = Buffer(N);
+	for (n = 0; n < N; n++)
+	{
+		const float a = in[n];
+		const float b = (n == 0) ? 0.0f : in[N - n];
+		pBuf[n].re = a * pRot[n].re - b * pRot[n].im;
+		pBuf[n].im = a * pRot[n].im + b * pRot[n].re;
+	}
+	plan->Forward(pBuf, pBuf);
+	if (N == 1)
+	{
+		out[0] = 0.5f * pBuf[0].re;
+		return true;
+	}
+	for (n = 0; n < N / 2; n++)
+	{
+		out[2 * n] = 0.5f * pBuf[n].re;
+		out[2 * n + 1] = 0.5f * pBuf[N - 1 - n].re;
+	}
+	return true;
+}
+/*DCT-IV：N/2 点复数 FFT
+z[n] = (x[2n] + j*x[N-1-2n]) * exp(-j*PI*(4n+1)/4N)，Z = FFT(z)，
+c[k] = Z[k] * exp(-j*PI*k/N)，y[2k] = Re(c[k])，y[N-1-2k] = -Im(c[k])*/
+bool CDctAlg::DCT4(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	if (nPower < 1)
+	{
+		out[0] = in[0] * (float)cos(PI / 4);
+		return true;
+	}
+	std::shared_ptr<const CFftPlan> plan = CFftPlan::Get(nPower - 1);
+	const int N = 1 << nPower;
+	const int H = N / 2;
+	const TCOMPLEX *pPre, *pPost;
+	Rotation4(nPower, &pPre, &pPost);
+	TCOMPLEX *pBuf = Buffer(H);
+	for (n = 0; n < H; n++)
+	{
+		const float a = in[2 * n];
+		const float b = in[N - 1 - 2 * n];
+		const TCOMPLEX w = pPre[n];
+		pBuf[n].re = a * w.re - b * w.im;
+		pBuf[n].im = a * w.im + b * w.re;
+	}
+	plan->Forward(pBuf, pBuf);
+	for (n = 0; n < H; n++)
+	{
+		const TCOMPLEX z = pBuf[n];
+		const TCOMPLEX w = pPost[n];
+		out[2 * n] = z.re * w.re - z.im * w.im;
+		out[N - 1 - 2 * n] = -(z.re * w.im + z.im * w.re);
+	}
+	return true;
+}
+/*DST-I：奇延拓到 2N 点，y[k-1] = -Im(U[k])/2*/
+bool CDctAlg::DST1(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 1)) return false;
+	std::shared_ptr<const CFftPlan> plan = CFftPlan::Get(nPower + 1);
+	const int N = 1 << nPower;
+	TCOMPLEX *pBuf = Buffer(2 * N);
+	pBuf[0].re = 0.0f;
+	pBuf[0].im = 0.0f;
+	pBuf[N].re = 0.0f;
+	pBuf[N].im = 0.0f;
+	for (n = 1; n < N; n++)
+	{
+		pBuf[n].re = in[n - 1];
+		pBuf[n].im = 0.0f;
+		pBuf[2 * N - n].re = -in[n - 1];
+		pBuf[2 * N - n].im = 0.0f;
+	}
+	plan->Forward(pBuf, pBuf);
+	for (n = 1; n < N; n++)
+		out[n - 1] = -0.5f * pBuf[n].im;
+	return true;
+}
+/*DST-II(x)[k] = DCT-II((-1)^n * x)[N-1-k]*/
+bool CDctAlg::DST2(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	const int N = 1 << nPower;
+	float *pTmp = Temp(N);
+	for (n = 0; n < N; n++)
+		pTmp[n] = (n & 1) ? -in[n] : in[n];
+	if (!DCT2(pTmp, pTmp, nPower)) return false;
+	for (n = 0; n < N; n++)
+		out[n] = pTmp[N - 1 - n];
+	return true;
+}
+/*DST-III(x)[k] = (-1)^k * DCT-III(x 反序)[k]*/
+bool CDctAlg::DST3(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	const int N = 1 << nPower;
+	float *pTmp = Temp(N);
+	for (n = 0; n < N; n++)
+		pTmp[n] = in[N - 1 - n];
+	DCT3(pTmp, out, nPower);
+	for (n = 1; n < N; n += 2)
+		out[n] = -out[n];
+	return true;
+}
+/*DST-IV(x)[k] = (-1)^k * DCT-IV(x 反序)[k]*/
+bool CDctAlg::DST4(const float *in, float *out, int nPower)
+{
+	int n;
+	if (!PowerOk(nPower, 0)) return false;
+	const int N = 1 << nPower;
+	float *pTmp = Temp(N);
+	for (n = 0; n < N; n++)
+		pTmp[n] = in[N - 1 - n];
+	DCT4(pTmp, out, nPower);
+	for (n = 1; n < N; n += 2)
+		out[n] = -out[n];
+	return true;
+}
+/*MDCT：输入（先乘窗）按 N/2 分成 a,b,c,d，折叠成 (-c_r - d, a - b_r) 后做 N 点 DCT-IV*/
+bool CDctAlg::MDCT(const float *in, float *out, int nPower, const float *window)
+{
+	int n;
+	if (nPower < 1 || !PowerOk(nPower, 0)) return false;
+	const int N = 1 << nPower;
+	const int H = N / 2;
+	float *pTmp = Temp(N);
+	for (n = 0; n < H; n++)
+	{
+		/*前半：-c[H-1-n] - d[n]*/
+		const int ic = N + H - 1 - n;
+		const int id = N + H + n;
+		float c = in[ic];
+		float d = in[id];
+		/*后半：a[n] - b[H-1-n]*/
+		const int ia = n;
+		const int ib = N - 1 - n;
+		float a = in[ia];
+		float b = in[ib];
+		if (window != NULL)
+		{
+			c *= window[ic];
+			d *= window[id];
+			a *= window[ia];
+			b *= window[ib];
+		}
+		pTmp[n] = -c - d;
+		pTmp[H + n] = a - b;
+	}
+	DCT4(pTmp, out, nPower);
+	return true;
+}
+/*IMDCT：u = DCT-IV(X)*2/N，展开为 (u2, -u2_r, -u1_r, -u1) 再乘窗*/
+bool CDctAlg::IMDCT(const float *in, float *out, int nPower, const float *window)
+{
+	int n;
+	if (nPower < 1 || !PowerOk(nPower, 0)) return false;
+	const int N = 1 << nPower;
+	const int H = N / 2;
+	const float scale = 2.0f / N;
+	float *pTmp = Temp(N);
+	DCT4(in, pTmp, nPower);
+	for (n = 0; n < H; n++)
+	{
+		const float u1 = pTmp[n] * scale;
+		const float u2 = pTmp[H + n] * scale;
+		out[n] = u2;
+		out[N - 1 - n] = -u2;
+		out[N + H - 1 - n] = -u1;
+		out[N + H + n] = -u1;
+	}
+	if (window != NULL)
+	{
+		for (n = 0; n < 2 * N; n++)
+			out[n] *= window[n];
+	}
+	return true;
+}
+void CDctAlg::SineWindow(float *window, int len)
+{
+	int n;
+	for (n = 0; n < len; n++)
+		window[n] = (float)sin(PI * (n + 0.5) / len);
+}
@@ -0,0 +1,75 @@
+/***********
+类名：CDctAlg.h
+描述：快速 DCT-I..IV / DST-I..IV / MDCT / IMDCT（均为不归一化定义）
+      全部映射到 CFftPlan 的复数 FFT 上，前后乘旋转因子：
+        DCT-II/III  -> N 点 FFT（Makhoul 重排）
+        DCT-IV      -> N/2 点 FFT
+        DCT-I/DST-I -> 2N 点 FFT（偶/奇延拓）
+        DST-x       -> 对应 DCT-x 加符号交替/反序
+        MDCT/IMDCT  -> 折叠 + N 点 DCT-IV
+      前后乘的旋转因子按 N（DCT-IV 为 N/2）点在实例里算一次缓存，FFT 工作区从计划的缓存里借（各实例共用），
+      同一长度反复调用不再分配内存。单个实例非线程安全，每线程各用一个。
+      nPower 超出范围（<0，或所需 FFT 超过 CFftPlan::MAX_POWER）时返回 false，不写 out。
+定义（N=2^nPower）：
+  DCT-I  (N+1 点)：y[k] = x[0]/2 + (-1)^k*x[N]/2 + sum_{n=1}^{N-1} x[n]cos(PI*n*k/N)
+  DCT-II        ：y[k] = sum x[n]cos(PI*(n+1/2)*k/N)
+  DCT-III       ：y[k] = x[0]/2 + sum_{n>=1} x[n]cos(PI*n*(k+1/2)/N)
+  DCT-IV        ：y[k] = sum x[n]cos(PI*(n+1/2)*(k+1/2)/N)
+  DST-I  (N-1 点)：y[k] = sum x[n]sin(PI*(n+1)*(k+1)/N)
+  DST-II        ：y[k] = sum x[n]sin(PI*(n+1/2)*(k+1)/N)
+  DST-III       ：y[k] = (-1)^k*x[N-1]/2 + sum_{n<N-1} x[n]sin(PI*(n+1)*(k+1/2)/N)
+  DST-IV        ：y[k] = sum x[n]sin(PI*(n+1/2)*(k+1/2)/N)
+  MDCT  (2N->N) ：X[k] = sum_{n<2N} w[n]x[n]cos(PI/N*(n+1/2+N/2)*(k+1/2))
+  IMDCT (N->2N) ：y[n] = w[n]*2/N * sum_k X[k]cos(PI/N*(n+1/2+N/2)*(k+1/2))
+  （分析、合成用同一个窗且 w[n]^2 + w[n+N]^2 = 1 时，IMDCT 结果 50% 重叠相加即可完全重建）
+  DCT-II 与 DCT-III 互逆（差 N/2 倍），DCT-IV 自逆（差 N/2 倍）。
+************/
+#ifndef _DCT_ALG_H_
+#define _DCT_ALG_H_
+#include <vector>
+#include "CFftPlan.h"
+
+class CDctAlg
+{
+public:
+	CDctAlg();
+	~CDctAlg();
+
+	// in 与 out 可以是同一块内存
+	bool DCT1(const float *in, float *out, int nPower);
+	bool DCT2(const float *in, float *out, int nPower);
+	bool DCT3(const float *in, float *out, int nPower);
+	bool DCT4(const float *in, float *out, int nPower);
+	bool DST1(const float *in, float *out, int nPower);
+	bool DST2(const float *in, float *out, int nPower);
+	bool DST3(const float *in, float *out, int nPower);
+	bool DST4(const float *in, float *out, int nPower);
+
+	// in 为 2N 点，out 为 N 点（nPower>=1）；window 为 2N 点，可为 NULL（矩形窗）
+	bool MDCT(const float *in, float *out, int nPower, const float *window);
+	// in 为 N 点，out 为 2N 点（已乘窗，直接与上一帧后半重叠相加）
+	bool IMDCT(const float *in, float *out, int nPower, const float *window);
+
+	// 正弦窗 w[n] = sin(PI*(n+1/2)/len)，满足 MDCT 的 Princen-Bradley 条件
+	static void SineWindow(float *window, int len);
+
+protected:
+
+private:
+	std::vector<TCOMPLEX> v_Buf;     // 变换缓冲
+	std::vector<float>    v_Tmp;     // 实数中间结果（DST/MDCT 的重排）
+
+	std::vector<TCOMPLEX> v_Rot23;   // DCT-II/III：exp(-j*PI*k/2N)，k<N
+	std::vector<TCOMPLEX> v_Rot4Pre; // DCT-IV：exp(-j*PI*(4n+1)/4N)，n<N/2
+	std::vector<TCOMPLEX> v_Rot4Post;// DCT-IV：exp(-j*PI*n/N)，n<N/2
+	int n_Rot23Power;
+	int n_Rot4Power;
+
+	TCOMPLEX *Buffer(int len);
+	float *Temp(int len);
+	const TCOMPLEX *Rotation23(int nPower);
+	void Rotation4(int nPower, const TCOMPLEX **pPre, const TCOMPLEX **pPost);
+	// 所需 FFT 为 2^(nPower+extra) 点：nPower>=0 且不超过 CFftPlan::MAX_POWER
+	static bool PowerOk(int nPower, int extra);
+};
+#endif
@@ -3,6 +3,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "CFftAlg.h"
+#include "CFftPlan.h"
 
 CFftAlg::CFftAlg()
 {
@@ -59,86 +60,16 @@ TCOMPLEX CFftAlg::ComplexMultiply(TCOMPLEX c1, TCOMPLEX c2)
 TDΪʱֵFDΪƵֵnPowerΪ2*/  
 void CFftAlg:: FFT_N(TCOMPLEX *TD, TCOMPLEX *FD, int nPower)  
 {  
-	int nCount;  
-	int nI,nJ,nK,nBfsize,nP;  
-	double dAngle;  
-	TCOMPLEX *pTw,*pTx1,*pTx2,*pTx;  
-	/*㸵Ҷ任*/
-	nCount = 1<<nPower; 
-	//printf("nCount = %d\n",nCount);
-	/*洢*/  
-	pTw = (TCOMPLEX *)malloc(sizeof(TCOMPLEX)*nCount/2);  
-	pTx1 = (TCOMPLEX *)malloc(sizeof(TCOMPLEX)*nCount);  
-	pTx2 = (TCOMPLEX *)malloc(sizeof(TCOMPLEX)*nCount);  
-	/*Ȩϵ*/
-	for(nI = 0; nI<nCount/2; nI++)  
-	{  
-		dAngle = -nI*PI*2/nCount;  
-		pTw[nI].re = (float)cos(dAngle);  
-		pTw[nI].im = (float)sin(dAngle);  
-	}  
-	/*ʱд洢*/
-	memcpy(pTx1, TD, sizeof(TCOMPLEX)*nCount);  
-	/**/
-	for(nK=0; nK<nPower; nK++)  
-	{  
-		for(nJ=0;nJ<1<<nK;nJ++)  
-		{  
-			nBfsize = 1 << ( nPower - nK );  
-			for(nI=0;nI<nBfsize/2;nI++)  
-			{  
-				nP=nJ*nBfsize;  
-				pTx2[nI+nP] = ComplexAdd(pTx1[nI+nP], pTx1[nI+nP+nBfsize/2]);  
-				pTx2[nI+nP+nBfsize/2] = ComplexMultiply(ComplexSub(pTx1[nI+nP], pTx1[nI+nP+nBfsize/2]),pTw[nI*(1<<nK)]);  
-			}  
-		}  
-		pTx  = pTx1;  
-		pTx1 = pTx2;  
-		pTx2 = pTx;  
-	}  
-	/**/  
-	for(nJ=0;nJ<nCount;nJ++)  
-	{  
-		nP=0;  
-		for(nI=0;nI<nPower;nI++)  
-		{  
-			if ( nJ&(1<<nI) )  
-				nP+=1 << (nPower-nI-1);  
-		}  
-		FD[nJ] = pTx1[nP];
-	}  
-	/*ͷŴ洢*/  
-	free(pTw);  
-	free(pTx1);  
-	free(pTx2);  
+	/*ȡļƻȨϵλֻ״ʹøõʱ㣻
+	Ҳɼƻ渴ãÿη*/
+	CFftPlan::Get(nPower)->Forward(TD, FD);
 } 
 /*ٸҶ任ÿٸҶ任 
 FDΪƵֵTDΪʱֵnPowerΪ2*/  
 void CFftAlg::IFFT_N(TCOMPLEX *FD, TCOMPLEX *TD, int nPower)  
 {  
-	int nI,nCount;  
-	TCOMPLEX *pTxx;  
-	/*㸵Ҷ任*/
-	nCount = 1<<nPower;
-	/*洢*/  
-	pTxx = (TCOMPLEX *)malloc(sizeof(TCOMPLEX)*nCount);  
-	/*Ƶд洢*/
-	memcpy(pTxx,FD,sizeof(TCOMPLEX)*nCount);  
-	/*ƵĹ*/
-	for(nI=0; nI<nCount; nI++)  
-	{  
-		pTxx[nI].im = -pTxx[nI].im;  
-	}  
-	/*ÿٸҶ任*/
-	FFT_N(pTxx,TD,nPower);  
-	/*ʱĹ*/
-	for(nI=0;nI<nCount;nI++)  
-	{  
-		TD[nI].re/=nCount;  
-		TD[nI].im=-TD[nI].im/nCount;  
-	}  
-	/*ͷŴ洢*/  
-	free(pTxx);  
+	/* -> 任 ->  NɼƻɣFD  TD ͬ*/
+	CFftPlan::Get(nPower)->Inverse(FD, TD);
 }  
 void CFftAlg::DoFFT()
 {
@@ -13,7 +13,6 @@ typedef struct
 }TCOMPLEX;
 /*ļ*/  
 #define  PI    3.1415926535897932384626433832795028841971
-#endif
 
 class CFftAlg
 {
@@ -44,4 +43,5 @@ private:
 	TCOMPLEX ComplexMultiply(TCOMPLEX c1, TCOMPLEX c2) ;
 	void FFT_N(TCOMPLEX *TD, TCOMPLEX *FD, int nPower)  ;
 	void IFFT_N(TCOMPLEX *FD, TCOMPLEX *TD, int nPower) ;
-};
\ No newline at end of file
+};
+#endif
@@ -0,0 +1,201 @@
+#pragma once
+#include <QObject>
+#include <QVector>
+#include <QList>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentRun>
+#include <memory>
+#include "CFftAlg.h"
+
+// 一帧 FFT 结果（CFftAlg 输出的拷贝，可跨线程传递）
+struct FftSpectrum {
+    quint64 seq = 0;           // 提交序号（submit 递增）
+    int     dataLen = 0;       // 点数（同 CFftAlg::SetData 的 dataLen）
+    float   sampleRate = 0;    // 采样率（同 CFftAlg::SetFreq）
+    float   freqMax = 0;       // 本帧幅度最大的频点（Hz，0 ~ sampleRate/2，含直流）
+    QVector<float> amplitude;  // CFftAlg::GetAmplitude()
+    QVector<float> freqIndex;  // CFftAlg::GetFreIndex()
+};
+Q_DECLARE_METATYPE(FftSpectrum)
+
+// CFftAlg 的异步前端：DoFFT 在线程池里跑，结果用 QFuture / spectrumReady 交付。
+// 新帧到来时，还没开始算的旧帧直接丢弃（future 被 cancel），
+// 已经算完但比已交付结果更旧的也丢弃，UI 始终只看到最新频谱。
+class CFftAsync final : public QObject {
+    Q_OBJECT
+public:
+    struct Config {
+        float sampleRate  = 16000; // 采样率（Hz）
+        int   maxInFlight = 1;     // 同时在算的帧数上限（>=1）
+        int   poolThreads = 0;     // 0=全局线程池；>0=独占线程池的线程数
+    };
+
+    // CFftAlg 内部是 1024 点定长数组，超出部分截断
+    static constexpr int kMaxDataLen = int(sizeof(CFftAlg::Mag_fft) / sizeof(float));
+
+    explicit CFftAsync(QObject* parent = nullptr)
+        : QObject(parent)
+    {
+        qRegisterMetaType<FftSpectrum>("FftSpectrum");
+    }
+
+    ~CFftAsync() override {
+        // 未交付的 future 全部取消，避免调用方永远等不到 finished
+        if (m_hasPending) cancelJob(m_pending, false);
+        for (Job& job : m_running) cancelJob(job, false);
+        m_ownPool.waitForDone();
+    }
+
+    void setConfig(const Config& cfg) {
+        m_cfg = cfg;
+        if (m_cfg.maxInFlight < 1) m_cfg.maxInFlight = 1;
+        if (m_cfg.poolThreads < 0) m_cfg.poolThreads = 0;
+        if (m_cfg.poolThreads > 0) m_ownPool.setMaxThreadCount(m_cfg.poolThreads);
+    }
+    Config config() const { return m_cfg; }
+
+    // 提交一帧（数据会被拷贝，调用后 data 可立即复用）
+    QFuture<FftSpectrum> submit(const float* data, int dataLen) {
+        if (dataLen < 0) dataLen = 0;
+        if (dataLen > kMaxDataLen) dataLen = kMaxDataLen;
+
+        Job job;
+        job.seq = ++m_seq;
+        job.frame = QVector<float>(dataLen);
+        for (int i = 0; i < dataLen; ++i) job.frame[i] = data[i];
+        job.fi.reportStarted();
+        QFuture<FftSpectrum> f = job.fi.future();
+
+        if (m_running.size() < m_cfg.maxInFlight) {
+            launch(job);
+        } else {
+            // 只保留一帧待算：旧的待算帧直接作废
+            if (m_hasPending) cancelJob(m_pending);
+            m_pending = job;
+            m_hasPending = true;
+        }
+        return f;
+    }
+
+    QFuture<FftSpectrum> submit(const QVector<float>& frame) {
+        return submit(frame.constData(), frame.size());
+    }
+
+    quint64 submittedCount() const { return m_seq; }
+    quint64 droppedCount() const { return m_dropped; }
+    int inFlight() const { return m_running.size() + (m_hasPending ? 1 : 0); }
+
+    // 用给定的 CFftAlg 实例算一帧并拷出结果（任意线程，实例不能同时被别的线程用）
+    static FftSpectrum compute(CFftAlg& fft, const float* data, int dataLen, float sampleRate, quint64 seq) {
+        if (dataLen > kMaxDataLen) dataLen = kMaxDataLen;
+        fft.SetFreq(sampleRate);
+        fft.SetData(const_cast<float*>(data), dataLen);
+        fft.DoFFT();
+
+        FftSpectrum s;
+        s.seq = seq;
+        s.dataLen = dataLen;
+        s.sampleRate = sampleRate;
+        const float* mag = fft.GetAmplitude();
+        const float* fre = fft.GetFreIndex();
+        s.amplitude = QVector<float>(s.dataLen);
+        s.freqIndex = QVector<float>(s.dataLen);
+        for (int i = 0; i < s.dataLen; ++i) {
+            s.amplitude[i] = mag[i];
+            s.freqIndex[i] = fre[i];
+        }
+        // 峰值按本帧的幅度自己找：CFftAlg::GetFreqMax 拿频率和幅度比、还跨帧保留，复用实例时不可用
+        // 实数输入的频谱对称，只看前一半（含 Nyquist）
+        const int half = qMin(s.dataLen, s.dataLen / 2 + 1);
+        int peak = 0;
+        for (int i = 1; i < half; ++i) {
+            if (mag[i] > mag[peak]) peak = i;
+        }
+        if (half > 0) s.freqMax = fre[peak];
+        return s;
+    }
+
+signals:
+    // 新的频谱（seq 严格递增）
+    void spectrumReady(const FftSpectrum& spectrum);
+    // 某帧被更新的帧淘汰
+    void spectrumDropped(quint64 seq);
+
+private:
+    struct Job {
+        quint64 seq = 0;
+        QVector<float> frame;
+        QFutureInterface<FftSpectrum> fi;
+    };
+
+    QThreadPool* pool() {
+        return (m_cfg.poolThreads > 0) ? &m_ownPool : QThreadPool::globalInstance();
+    }
+
+    void launch(const Job& job) {
+        m_running.append(job);
+
+        const QVector<float> frame = job.frame;
+        const float sampleRate = m_cfg.sampleRate;
+        const quint64 seq = job.seq;
+
+        auto* watcher = new QFutureWatcher<FftSpectrum>(this);
+        connect(watcher, &QFutureWatcher<FftSpectrum>::finished, this, [this, watcher, seq]() {
+            onJobFinished(seq, watcher->result());
+            watcher->deleteLater();
+        });
+        watcher->setFuture(QtConcurrent::run(pool(), [frame, sampleRate, seq]() {
+            // CFftAlg 有状态且较大（~24KB），每个任务一个实例
+            std::unique_ptr<CFftAlg> fft(new CFftAlg);
+            return compute(*fft, frame.constData(), frame.size(), sampleRate, seq);
+        }));
+    }
+
+    void onJobFinished(quint64 seq, const FftSpectrum& result) {
+        Job job;
+        for (int i = 0; i < m_running.size(); ++i) {
+            if (m_running[i].seq == seq) {
+                job = m_running.takeAt(i);
+                break;
+            }
+        }
+
+        if (seq > m_lastDelivered) {
+            m_lastDelivered = seq;
+            job.fi.reportResult(result);
+            job.fi.reportFinished();
+            emit spectrumReady(result);
+        } else {
+            // 乱序完成：已有更新的结果交付过
+            cancelJob(job);
+        }
+
+        if (m_hasPending && m_running.size() < m_cfg.maxInFlight) {
+            m_hasPending = false;
+            launch(m_pending);
+            m_pending = Job();
+        }
+    }
+
+    void cancelJob(Job& job, bool notify = true) {
+        job.fi.reportCanceled();
+        job.fi.reportFinished();
+        ++m_dropped;
+        if (notify) emit spectrumDropped(job.seq);
+    }
+
+private:
+    Config m_cfg;
+    QThreadPool m_ownPool;
+
+    quint64 m_seq = 0;           // 最近一次 submit 的序号
+    quint64 m_lastDelivered = 0; // 最近一次交付的序号
+    quint64 m_dropped = 0;
+
+    QList<Job> m_running;        // 正在线程池里算的帧
+    Job  m_pending;              // 等待的最新帧（最多一帧）
+    bool m_hasPending = false;
+};
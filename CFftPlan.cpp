@@ -0,0 +1,261 @@
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include "CFftPlan.h"
+
+CFftPlan::CFftPlan(int nPower)
+{
+	int nI, nJ, nP;
+	double dAngle;
+	n_Power = nPower;
+	n_Count = 1 << nPower;
+	v_Tw.resize(n_Count / 2 > 0 ? n_Count / 2 : 1);
+	v_Rev.resize(n_Count);
+	/*计算加权系数*/
+	for (nI = 0; nI < n_Count / 2; nI++)
+	{
+		dAngle = -nI * PI * 2 / n_Count;
+		v_Tw[nI].re = (float)cos(dAngle);
+		v_Tw[nI].im = (float)sin(dAngle);
+	}
+	/*倒位序表*/
+	for (nJ = 0; nJ < n_Count; nJ++)
+	{
+		nP = 0;
+		for (nI = 0; nI < nPower; nI++)
+		{
+			if (nJ & (1 << nI))
+				nP += 1 << (nPower - nI - 1);
+		}
+		v_Rev[nJ] = nP;
+	}
+}
+CFftPlan::~CFftPlan()
+{
+}
+std::shared_ptr<const CFftPlan> CFftPlan::Get(int nPower)
+{
+	static std::mutex s_Lock;
+	static std::map<int, std::shared_ptr<const CFftPlan> > s_Cache;
+
+	if (nPower < 0) nPower = 0;
+	if (nPower > MAX_POWER) nPower = MAX_POWER;
+
+	std::lock_guard<std::mutex> guard(s_Lock);
+	std::shared_ptr<const CFftPlan> &slot = s_Cache[nPower];
+	if (!slot)
+		slot = std::make_shared<CFftPlan>(nPower);
+	return slot;
+}
+/*快速傅立叶变换（与 CFftAlg::FFT_N 同一蝶形顺序）*/
+void CFftPlan::Forward(const TCOMPLEX *TD, TCOMPLEX *FD, TCOMPLEX *work) const
+{
+	int nI, nJ, nK, nBfsize, nHalf, nP;
+	TCOMPLEX *pTx1 = work;
+	TCOMPLEX *pTx2 = work + n_Count;
+	TCOMPLEX *pTx;
+	const TCOMPLEX *pTw = &v_Tw[0];
+
+	memcpy(pTx1, TD, sizeof(TCOMPLEX) * n_Count);
+	for (nK = 0; nK < n_Power; nK++)
+	{
+		nBfsize = 1 << (n_Power - nK);
+		nHalf = nBfsize / 2;
+		for (nJ = 0; nJ < 1 << nK; nJ++)
+		{
+			nP = nJ * nBfsize;
+			for (nI = 0; nI < nHalf; nI++)
+			{
+				const TCOMPLEX a = pTx1[nI + nP];
+				const TCOMPLEX b = pTx1[nI + nP + nHalf];
+				const TCOMPLEX w = pTw[nI << nK];
+				const float dre = a.re - b.re;
+				const float dim = a.im - b.im;
+				pTx2[nI + nP].re = a.re + b.re;
+				pTx2[nI + nP].im = a.im + b.im;
+				pTx2[nI + nP + nHalf].re = dre * w.re - dim * w.im;
+				pTx2[nI + nP + nHalf].im = dre * w.im + dim * w.re;
+			}
+		}
+		pTx  = pTx1;
+		pTx1 = pTx2;
+		pTx2 = pTx;
+	}
+	/*倒位序输出*/
+	const int *pRev = &v_Rev[0];
+	for (nJ = 0; nJ < n_Count; nJ++)
+	{
+		FD[nJ] = pTx1[pRev[nJ]];
+	}
+}
+/*快速傅立叶逆变换：共轭 -> 正变换 -> 共轭并除以 N*/
+void CFftPlan::Inverse(const TCOMPLEX *FD, TCOMPLEX *TD, TCOMPLEX *work) const
+{
+	int nI;
+	for (nI = 0; nI < n_Count; nI++)
+	{
+		TD[nI].re = FD[nI].re;
+		TD[nI].im = -FD[nI].im;
+	}
+	Forward(TD, TD, work);
+	for (nI = 0; nI < n_Count; nI++)
+	{
+		TD[nI].re /= n_Count;
+		TD[nI].im = -TD[nI].im / n_Count;
+	}
+}
+
+/*借一块工作区，析构时还回计划的缓存*/
+class CFftPlan::CWorkLease
+{
+public:
+	explicit CWorkLease(const CFftPlan &plan) : r_Plan(plan)
+	{
+		{
+			std::lock_guard<std::mutex> guard(plan.m_WorkLock);
+			if (!plan.v_FreeWork.empty())
+			{
+				v_Buf.swap(plan.v_FreeWork.back());
+				plan.v_FreeWork.pop_back();
+			}
+		}
+		if (v_Buf.empty())
+			v_Buf.resize(plan.GetWorkLen());
+	}
+	~CWorkLease()
+	{
+		std::lock_guard<std::mutex> guard(r_Plan.m_WorkLock);
+		r_Plan.v_FreeWork.push_back(std::vector<TCOMPLEX>());
+		r_Plan.v_FreeWork.back().swap(v_Buf);
+	}
+	TCOMPLEX * Get() { return &v_Buf[0]; }
+
+private:
+	const CFftPlan &r_Plan;
+	std::vector<TCOMPLEX> v_Buf;
+};
+void CFftPlan::Forward(const TCOMPLEX *TD, TCOMPLEX *FD) const
+{
+	CWorkLease work(*this);
+	Forward(TD, FD, work.Get());
+}
+void CFftPlan::Inverse(const TCOMPLEX *FD, TCOMPLEX *TD) const
+{
+	CWorkLease work(*this);
+	Inverse(FD, TD, work.Get());
+}
+
+int FftThreadCount(int threads)
+{
+	if (threads <= 0)
+	{
+		threads = (int)std::thread::hardware_concurrency();
+		if (threads <= 0) threads = 1;
+	}
+	return threads;
+}
+/*FftParallelFor 专用的常驻线程池：核数-1 个线程，第一次用时创建，之后一直复用。
+只用标准库，CFftPlan/CFftAlg 不依赖 Qt；也不和 QThreadPool 上的其他任务抢线程。
+对象故意不析构：进程退出时工作线程可能还停在等任务上*/
+class CFftWorkerPool
+{
+public:
+	static CFftWorkerPool &Instance()
+	{
+		static CFftWorkerPool *s_Pool = new CFftWorkerPool();
+		return *s_Pool;
+	}
+	void Post(const std::function<void()> &task)
+	{
+		{
+			std::lock_guard<std::mutex> guard(m_Lock);
+			q_Tasks.push_back(task);
+		}
+		m_Cv.notify_one();
+	}
+
+private:
+	CFftWorkerPool()
+	{
+		int t;
+		const int threads = FftThreadCount(0) - 1;
+		for (t = 0; t < (threads > 0 ? threads : 1); t++)
+			std::thread(&CFftWorkerPool::Loop, this).detach();
+	}
+	void Loop()
+	{
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> guard(m_Lock);
+				m_Cv.wait(guard, [this]() { return !q_Tasks.empty(); });
+				task.swap(q_Tasks.front());
+				q_Tasks.pop_front();
+			}
+			task();
+		}
+	}
+
+	std::mutex m_Lock;
+	std::condition_variable m_Cv;
+	std::deque<std::function<void()> > q_Tasks;
+};
+/*一次 FftParallelFor 的共享状态：段号按领取顺序发出，池任务晚启动时段已领完就直接退出*/
+struct FftParallelState
+{
+	int count;
+	int chunks;
+	const std::function<void(int, int, int)> *fn;
+	std::atomic<int> next;
+	int done;
+	std::mutex lock;
+	std::condition_variable cv;
+
+	/*领段执行直到领完；worker 在同一时刻唯一（每个参与者串行执行自己领到的段）*/
+	void Run(int worker)
+	{
+		int c;
+		while ((c = next.fetch_add(1)) < chunks)
+		{
+			const int b = (int)((long long)count * c / chunks);
+			const int e = (int)((long long)count * (c + 1) / chunks);
+			(*fn)(b, e, worker);
+			std::lock_guard<std::mutex> guard(lock);
+			if (++done == chunks)
+				cv.notify_all();
+		}
+	}
+};
+void FftParallelFor(int count, int threads, const std::function<void(int, int, int)> &fn)
+{
+	int t;
+	if (count <= 0) return;
+	threads = FftThreadCount(threads);
+	if (threads > count) threads = count;
+	if (threads <= 1)
+	{
+		fn(0, count, 0);
+		return;
+	}
+	std::shared_ptr<FftParallelState> st = std::make_shared<FftParallelState>();
+	st->count = count;
+	st->chunks = threads;
+	st->fn = &fn;
+	st->next = 0;
+	st->done = 0;
+	CFftWorkerPool &pool = CFftWorkerPool::Instance();
+	for (t = 1; t < threads; t++)
+	{
+		pool.Post([st, t]() { st->Run(t); });
+	}
+	st->Run(0);
+	/*只等已经被池任务领走、还没做完的段*/
+	std::unique_lock<std::mutex> guard(st->lock);
+	st->cv.wait(guard, [&st]() { return st->done == st->chunks; });
+}
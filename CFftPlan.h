@@ -0,0 +1,59 @@
+/***********
+类名：CFftPlan.h
+描述：FFT 计划（旋转因子 + 倒位序表），按 nPower 全局缓存共享
+      算法与 CFftAlg::FFT_N 相同（频域抽取 + 倒位序输出），结果逐位一致；
+      计划只读，多线程可同时使用同一个计划，各自提供工作区即可。
+************/
+#ifndef _FFT_PLAN_H_
+#define _FFT_PLAN_H_
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <functional>
+#include "CFftAlg.h"
+
+class CFftPlan
+{
+public:
+	enum { MAX_POWER = 24 };
+
+	// 取 2^nPower 点的计划（首次调用时创建，之后直接返回缓存）
+	static std::shared_ptr<const CFftPlan> Get(int nPower);
+
+	int GetPower() const { return n_Power; }
+	int GetCount() const { return n_Count; }
+	// Forward/Inverse 需要的工作区长度（TCOMPLEX 个数）
+	int GetWorkLen() const { return 2 * n_Count; }
+
+	// 正变换：TD 时域 -> FD 频域；TD 与 FD 可以是同一块内存
+	void Forward(const TCOMPLEX *TD, TCOMPLEX *FD, TCOMPLEX *work) const;
+	// 逆变换（含 1/N）：FD 频域 -> TD 时域，同 CFftAlg::IFFT_N；FD 与 TD 可以相同
+	void Inverse(const TCOMPLEX *FD, TCOMPLEX *TD, TCOMPLEX *work) const;
+	// 不带工作区的版本：工作区从本计划的缓存里借（首次用时分配，之后复用），多线程各借各的
+	void Forward(const TCOMPLEX *TD, TCOMPLEX *FD) const;
+	void Inverse(const TCOMPLEX *FD, TCOMPLEX *TD) const;
+
+	const TCOMPLEX * GetTwiddle() const { return &v_Tw[0]; }
+
+	explicit CFftPlan(int nPower);
+	~CFftPlan();
+
+private:
+	int n_Power;
+	int n_Count;
+	std::vector<TCOMPLEX> v_Tw;     // N/2 个旋转因子 exp(-j*2*PI*i/N)
+	std::vector<int>      v_Rev;    // 倒位序表
+
+	// 工作区缓存：借出时从空闲表取，还回时放回，同时使用的线程数决定缓存个数
+	class CWorkLease;
+	mutable std::mutex m_WorkLock;
+	mutable std::vector<std::vector<TCOMPLEX> > v_FreeWork;
+};
+
+/*把 [0,count) 切成若干段并行执行 fn(begin, end, worker)
+threads<=0 取 CPU 核数；worker 为 0..threads-1，可用来索引各线程私有工作区
+在 CFftPlan 自己的常驻线程池（std::thread）上跑，不再每次起线程；调用线程也领段执行，
+线程池忙（或本身就在池里调用）时由调用线程把剩下的段做完，不会互相等死*/
+int FftThreadCount(int threads);
+void FftParallelFor(int count, int threads, const std::function<void(int, int, int)> &fn);
+#endif
@@ -0,0 +1,112 @@
+#include <math.h>
+#include "CHilbertAlg.h"
+
+CHilbertAlg::CHilbertAlg()
+{
+	n_Power = 0;
+	n_Count = 0;
+	n_Threads = 1;
+}
+CHilbertAlg::~CHilbertAlg()
+{
+}
+void CHilbertAlg::Setup(int nPower, int threads)
+{
+	if (nPower < 1) nPower = 1;
+	p_Plan = CFftPlan::Get(nPower);
+	n_Power = p_Plan->GetPower();
+	n_Count = p_Plan->GetCount();
+	n_Threads = FftThreadCount(threads);
+	v_Work.resize((size_t)n_Threads * 3 * n_Count);
+}
+/*正变换 + 频域掩模 + 逆变换前的共轭，结果留在 pBuf 里：
+pBuf = conj(H(X))，H：DC、Nyquist 乘 1，正频率乘 2，负频率清零
+之后再做一次正变换，conj(...)/N 即为解析信号*/
+void CHilbertAlg::ForwardMasked(const float *in, TCOMPLEX *pBuf, TCOMPLEX *pWork)
+{
+	int n;
+	const int N = n_Count;
+	const int H = N / 2;
+	for (n = 0; n < N; n++)
+	{
+		pBuf[n].re = in[n];
+		pBuf[n].im = 0.0f;
+	}
+	p_Plan->Forward(pBuf, pBuf, pWork);
+
+	pBuf[0].im = -pBuf[0].im;
+	pBuf[H].im = -pBuf[H].im;
+	for (n = 1; n < H; n++)
+	{
+		pBuf[n].re = 2.0f * pBuf[n].re;
+		pBuf[n].im = -2.0f * pBuf[n].im;
+	}
+	for (n = H + 1; n < N; n++)
+	{
+		pBuf[n].re = 0.0f;
+		pBuf[n].im = 0.0f;
+	}
+	p_Plan->Forward(pBuf, pBuf, pWork);
+}
+bool CHilbertAlg::Analytic(const float *in, TCOMPLEX *out)
+{
+	int n;
+	if (n_Count <= 0) return false;   /*未 Setup*/
+	TCOMPLEX *pBuf = Scratch(0);
+	const float scale = 1.0f / n_Count;
+	ForwardMasked(in, pBuf, pBuf + n_Count);
+	for (n = 0; n < n_Count; n++)
+	{
+		out[n].re = pBuf[n].re * scale;
+		out[n].im = -pBuf[n].im * scale;
+	}
+	return true;
+}
+void CHilbertAlg::Channel(const float *in, float *envelope, float *phase, float *envSpec, int worker)
+{
+	int n;
+	TCOMPLEX *pBuf = Scratch(worker);
+	TCOMPLEX *pWork = pBuf + n_Count;
+	const float scale = 1.0f / n_Count;
+	double sum = 0.0;
+
+	ForwardMasked(in, pBuf, pWork);
+	/*逆变换的收尾（共轭、除 N）与包络/相位计算合并*/
+	for (n = 0; n < n_Count; n++)
+	{
+		const float re = pBuf[n].re * scale;
+		const float im = -pBuf[n].im * scale;
+		const float env = sqrtf(re * re + im * im);
+		envelope[n] = env;
+		sum += env;
+		if (phase != NULL)
+			phase[n] = atan2f(im, re);
+	}
+	if (envSpec == NULL)
+		return;
+
+	/*包络谱：去均值后的包络再做一次正变换，复用同一块缓冲*/
+	const float mean = (float)(sum / n_Count);
+	for (n = 0; n < n_Count; n++)
+	{
+		pBuf[n].re = envelope[n] - mean;
+		pBuf[n].im = 0.0f;
+	}
+	p_Plan->Forward(pBuf, pBuf, pWork);
+	for (n = 0; n <= n_Count / 2; n++)
+		envSpec[n] = sqrtf(pBuf[n].re * pBuf[n].re + pBuf[n].im * pBuf[n].im);
+}
+void CHilbertAlg::Process(const float * const *in, int channels,
+	float * const *envelope, float * const *phase, float * const *envSpec)
+{
+	if (n_Count <= 0 || channels <= 0) return;
+	FftParallelFor(channels, n_Threads, [this, in, envelope, phase, envSpec](int b, int e, int worker) {
+		for (int c = b; c < e; c++)
+		{
+			Channel(in[c], envelope[c],
+				(phase != NULL) ? phase[c] : NULL,
+				(envSpec != NULL) ? envSpec[c] : NULL,
+				worker);
+		}
+	});
+}
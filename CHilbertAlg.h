@@ -0,0 +1,49 @@
+/***********
+类名：CHilbertAlg.h
+描述：希尔伯特变换 / 解析信号，多通道批量求包络、瞬时相位、包络谱（轴承故障诊断用）
+      每通道一次融合流程：正变换 -> 负频率清零、正频率加倍（与逆变换的共轭合并在同一遍里）
+      -> 逆变换 -> 直接算出包络/相位，不落地中间的解析信号。
+      各线程的缓冲在 Setup 时一次分配，之后每帧处理不再分配内存。
+************/
+#ifndef _HILBERT_ALG_H_
+#define _HILBERT_ALG_H_
+#include <memory>
+#include <vector>
+#include "CFftPlan.h"
+
+class CHilbertAlg
+{
+public:
+	CHilbertAlg();
+	~CHilbertAlg();
+
+	// 每通道 2^nPower 点；threads<=0 取 CPU 核数
+	void Setup(int nPower, int threads = 0);
+
+	int GetCount() const { return n_Count; }
+	int GetSpectrumLen() const { return n_Count / 2 + 1; }
+
+	// 单通道解析信号 x + j*H{x}，out 为 N 点；未 Setup 时返回 false，不写 out
+	bool Analytic(const float *in, TCOMPLEX *out);
+
+	/*批量处理 channels 个通道（按通道分给各线程）：
+	envelope[c]：N 点包络 |x + j*H{x}|
+	phase[c]   ：N 点瞬时相位 atan2(H{x}, x)（-PI~PI），可为 NULL
+	envSpec[c] ：N/2+1 点包络谱幅值（先去掉包络均值），可为 NULL*/
+	void Process(const float * const *in, int channels,
+		float * const *envelope, float * const *phase, float * const *envSpec);
+
+protected:
+
+private:
+	int n_Power;
+	int n_Count;
+	int n_Threads;
+	std::shared_ptr<const CFftPlan> p_Plan;
+	std::vector<TCOMPLEX> v_Work;    // 每线程：N 点缓冲 + 2N 点 FFT 工作区
+
+	TCOMPLEX *Scratch(int worker) { return &v_Work[(size_t)worker * 3 * n_Count]; }
+	void Channel(const float *in, float *envelope, float *phase, float *envSpec, int worker);
+	void ForwardMasked(const float *in, TCOMPLEX *pBuf, TCOMPLEX *pWork);
+};
+#endif
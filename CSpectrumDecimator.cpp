@@ -0,0 +1,162 @@
+#include <math.h>
+#include "CSpectrumDecimator.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SPECDEC_SSE2 1
+#endif
+
+CSpectrumDecimator::CSpectrumDecimator()
+{
+	n_Bins = 0;
+	n_Width = 0;
+	n_Axis = AXIS_LINEAR;
+	n_First = 0;
+	f_BinHz = 1.0f;
+}
+CSpectrumDecimator::~CSpectrumDecimator()
+{
+}
+/*生成 bin->像素 索引表
+每个像素至少对应 1 条谱线：谱线比像素少（或对数轴低频端）时相邻像素会重复同一条谱线*/
+void CSpectrumDecimator::Setup(int binCount, int pixelWidth, int axisMode, float binHz, int firstBin)
+{
+	int p;
+	if (binCount < 1) binCount = 1;
+	if (pixelWidth < 1) pixelWidth = 1;
+	if (axisMode != AXIS_LOG) axisMode = AXIS_LINEAR;
+	if (firstBin < 0) firstBin = (axisMode == AXIS_LOG) ? 1 : 0;
+	if (axisMode == AXIS_LOG && firstBin < 1) firstBin = 1;
+	if (firstBin > binCount - 1) firstBin = binCount - 1;
+
+	if (binCount == n_Bins && pixelWidth == n_Width && axisMode == n_Axis &&
+		firstBin == n_First && binHz == f_BinHz)
+		return;
+
+	n_Bins = binCount;
+	n_Width = pixelWidth;
+	n_Axis = axisMode;
+	n_First = firstBin;
+	f_BinHz = binHz;
+	v_Begin.resize(pixelWidth);
+	v_End.resize(pixelWidth);
+	v_Freq.resize(pixelWidth);
+
+	/*像素边界（浮点谱线坐标）：线性均分，或按 log(bin) 均分*/
+	const double lo = firstBin;
+	const double hi = binCount;
+	const double logLo = log(lo > 0 ? lo : 1.0);
+	const double logHi = log(hi);
+	for (p = 0; p < pixelWidth; p++)
+	{
+		double e0, e1;
+		if (axisMode == AXIS_LOG)
+		{
+			e0 = exp(logLo + (logHi - logLo) * p / pixelWidth);
+			e1 = exp(logLo + (logHi - logLo) * (p + 1) / pixelWidth);
+		}
+		else
+		{
+			e0 = lo + (hi - lo) * p / pixelWidth;
+			e1 = lo + (hi - lo) * (p + 1) / pixelWidth;
+		}
+		int b0 = (int)floor(e0);
+		int b1;
+		if (b0 < firstBin) b0 = firstBin;
+		if (b0 > binCount - 1) b0 = binCount - 1;
+		if (e1 - e0 < 1.0)
+		{
+			/*像素不足一条谱线：相邻像素重复 floor(e0) 这条*/
+			b1 = b0 + 1;
+		}
+		else
+		{
+			/*跨一条以上谱线：起点不早于上一像素终点，避免相邻像素重叠*/
+			if (p > 0 && b0 < v_End[p - 1]) b0 = v_End[p - 1];
+			if (b0 > binCount - 1) b0 = binCount - 1;
+			b1 = (int)ceil(e1);
+			if (b1 > binCount) b1 = binCount;
+			if (b1 <= b0) b1 = b0 + 1;
+		}
+		v_Begin[p] = b0;
+		v_End[p] = b1;
+		v_Freq[p] = (float)(0.5 * (e0 + e1) * binHz);
+	}
+}
+/*区间 [begin,end) 的最小值、最大值、最大值位置*/
+void CSpectrumDecimator::RangeMinMax(const float *p, int begin, int end, float *pMin, float *pMax, int *pArgMax)
+{
+	int i = begin;
+	float vMin = p[i];
+	float vMax = p[i];
+	int iMax = i;
+	i++;
+#ifdef SPECDEC_SSE2
+	if (end - i >= 8)
+	{
+		__m128 mn = _mm_set1_ps(vMin);
+		__m128 mx = _mm_set1_ps(vMax);
+		__m128i ix = _mm_set1_epi32(iMax);
+		__m128i cur = _mm_setr_epi32(i, i + 1, i + 2, i + 3);
+		const __m128i step = _mm_set1_epi32(4);
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 v = _mm_loadu_ps(p + i);
+			__m128 gt = _mm_cmpgt_ps(v, mx);
+			__m128i gti = _mm_castps_si128(gt);
+			ix = _mm_or_si128(_mm_and_si128(gti, cur), _mm_andnot_si128(gti, ix));
+			mx = _mm_max_ps(mx, v);
+			mn = _mm_min_ps(mn, v);
+			cur = _mm_add_epi32(cur, step);
+		}
+		float lMin[4], lMax[4];
+		int lIdx[4];
+		_mm_storeu_ps(lMin, mn);
+		_mm_storeu_ps(lMax, mx);
+		_mm_storeu_si128((__m128i *)lIdx, ix);
+		for (int k = 0; k < 4; k++)
+		{
+			if (lMin[k] < vMin) vMin = lMin[k];
+			/*同值取最靠前的谱线，与标量路径一致*/
+			if (lMax[k] > vMax || (lMax[k] == vMax && lIdx[k] < iMax))
+			{
+				vMax = lMax[k];
+				iMax = lIdx[k];
+			}
+		}
+	}
+#endif
+	for (; i < end; i++)
+	{
+		if (p[i] < vMin) vMin = p[i];
+		if (p[i] > vMax)
+		{
+			vMax = p[i];
+			iMax = i;
+		}
+	}
+	*pMin = vMin;
+	*pMax = vMax;
+	*pArgMax = iMax;
+}
+void CSpectrumDecimator::Reduce(const float *amp, float *outMin, float *outMax, int *outPeakBin) const
+{
+	int p;
+	int peak;
+	for (p = 0; p < n_Width; p++)
+	{
+		RangeMinMax(amp, v_Begin[p], v_End[p], &outMin[p], &outMax[p], &peak);
+		if (outPeakBin != NULL) outPeakBin[p] = peak;
+	}
+}
+const int * CSpectrumDecimator::GetPixelBegin() const
+{
+	return v_Begin.empty() ? NULL : &v_Begin[0];
+}
+const int * CSpectrumDecimator::GetPixelEnd() const
+{
+	return v_End.empty() ? NULL : &v_End[0];
+}
+const float * CSpectrumDecimator::GetPixelFreq() const
+{
+	return v_Freq.empty() ? NULL : &v_Freq[0];
+}
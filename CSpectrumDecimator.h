@@ -0,0 +1,52 @@
+/***********
+类名：CSpectrumDecimator.h
+描述：频谱抽取（按屏幕像素归并）
+      把 CFftAlg::GetAmplitude() 这类 N 点幅值谱归并成每像素一列的
+      min/max 包络和峰值位置，绘图只需遍历 pixelWidth 个点。
+用法：Setup() 一次性算好 bin->像素 索引表（参数不变时重复调用无开销），
+      之后每帧调用 Reduce()。
+************/
+#ifndef _SPECTRUM_DECIMATOR_H_
+#define _SPECTRUM_DECIMATOR_H_
+#include <vector>
+
+class CSpectrumDecimator
+{
+public:
+	enum AxisMode
+	{
+		AXIS_LINEAR = 0,        // 线性频率轴
+		AXIS_LOG    = 1         // 对数频率轴（不含 DC）
+	};
+
+	CSpectrumDecimator();
+	~CSpectrumDecimator();
+
+	// binCount：谱线数；pixelWidth：控件宽度；binHz：每条谱线的频率间隔（Freq/N）
+	// firstBin：起始谱线，<0 时线性轴取 0，对数轴取 1
+	void Setup(int binCount, int pixelWidth, int axisMode, float binHz = 1.0f, int firstBin = -1);
+
+	// amp 长度 >= binCount；outMin/outMax 长度 >= pixelWidth；outPeakBin 可为 NULL
+	void Reduce(const float *amp, float *outMin, float *outMax, int *outPeakBin) const;
+
+	int GetPixelWidth() const { return n_Width; }
+	int GetBinCount() const { return n_Bins; }
+	const int * GetPixelBegin() const;          // 每像素起始谱线（含）
+	const int * GetPixelEnd() const;            // 每像素结束谱线（不含）
+	const float * GetPixelFreq() const;         // 每像素中心频率（Hz），作 X 坐标
+
+protected:
+
+private:
+	int   n_Bins;
+	int   n_Width;
+	int   n_Axis;
+	int   n_First;
+	float f_BinHz;
+	std::vector<int>   v_Begin;
+	std::vector<int>   v_End;
+	std::vector<float> v_Freq;
+
+	static void RangeMinMax(const float *p, int begin, int end, float *pMin, float *pMax, int *pArgMax);
+};
+#endif
@@ -0,0 +1,175 @@
+#include "CmdSession.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QThread>
+
+ShellCmdSession::Shell ShellCmdSession::windowsCmd()
+{
+    Shell s;
+    s.program = "cmd";
+    s.arguments = QStringList{"/q"};
+    s.newline = "\r\n";
+    s.echoFormat = "echo %1";
+    return s;
+}
+
+ShellCmdSession::Shell ShellCmdSession::posixShell(const QString &path)
+{
+    Shell s;
+    s.program = path;
+    s.newline = "\n";
+    s.echoFormat = "echo %1";
+    return s;
+}
+
+ShellCmdSession::ShellCmdSession(const Shell &shell)
+    : m_shell(shell)
+    , m_thread(new QThread)
+    , m_context(new QObject)
+{
+    m_thread->setObjectName("ShellCmdSession");
+    m_context->moveToThread(m_thread);
+    m_thread->start();
+}
+
+ShellCmdSession::~ShellCmdSession()
+{
+    // 壳进程在工作线程上杀掉、销毁，再收线程
+    callOnWorker([this] {
+        QMutexLocker lock(&m_mutex);
+        stop();
+    });
+    m_thread->quit();
+    m_thread->wait();
+    delete m_context;
+    delete m_thread;
+}
+
+void ShellCmdSession::callOnWorker(const std::function<void()> &fn) const
+{
+    if (QThread::currentThread() == m_thread)
+        fn();
+    else
+        QMetaObject::invokeMethod(m_context, fn, Qt::BlockingQueuedConnection);
+}
+
+bool ShellCmdSession::isAlive() const
+{
+    bool alive = false;
+    callOnWorker([this, &alive] {
+        QMutexLocker lock(&m_mutex);
+        alive = m_proc && m_proc->state() == QProcess::Running;
+    });
+    return alive;
+}
+
+int ShellCmdSession::restartCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_starts > 0 ? m_starts - 1 : 0;
+}
+
+QString ShellCmdSession::run(const QString &cmd, int timeoutMs)
+{
+    QString out;
+    callOnWorker([this, &cmd, timeoutMs, &out] { out = runOnWorker(cmd, timeoutMs); });
+    return out;
+}
+
+QString ShellCmdSession::runOnWorker(const QString &cmd, int timeoutMs)
+{
+    QMutexLocker lock(&m_mutex);
+
+    QElapsedTimer clock;
+    clock.start();
+    if (!ensureStarted(timeoutMs))
+        return QString();
+
+    const QByteArray marker = nextMarker();
+    QByteArray script = cmd.toLocal8Bit();
+    script += m_shell.newline;
+    script += m_shell.echoFormat.arg(QString::fromLatin1(marker)).toLocal8Bit();
+    script += m_shell.newline;
+    m_proc->write(script);
+
+    QByteArray out;
+    const int remaining = qMax(1, timeoutMs - int(clock.elapsed()));
+    if (!readUntil(marker, remaining, out)) {
+        // 超时或壳退出：后面的输出和哨兵对不上了，整个壳作废，下一条命令重启
+        stop();
+        return QString();
+    }
+    return QString::fromLocal8Bit(out);
+}
+
+bool ShellCmdSession::ensureStarted(int timeoutMs)
+{
+    if (m_proc && m_proc->state() == QProcess::Running)
+        return true;
+
+    stop();
+    m_proc.reset(new QProcess);
+    m_proc->setStandardErrorFile(QProcess::nullDevice()); // 同 runCmd：只要 stdout
+    m_proc->start(m_shell.program, m_shell.arguments);
+    ++m_starts;
+    if (!m_proc->waitForStarted(timeoutMs)) {
+        stop();
+        return false;
+    }
+
+    // 握手：丢掉启动横幅（cmd 会打印版本信息），顺便确认壳能响应
+    const QByteArray marker = nextMarker();
+    m_proc->write(m_shell.echoFormat.arg(QString::fromLatin1(marker)).toLocal8Bit() + m_shell.newline);
+    QByteArray banner;
+    if (!readUntil(marker, timeoutMs, banner)) {
+        stop();
+        return false;
+    }
+    return true;
+}
+
+// 读到哨兵为止：哨兵之前的是这条命令的输出，哨兵和它后面的换行丢掉，剩下的留给下一条
+bool ShellCmdSession::readUntil(const QByteArray &marker, int timeoutMs, QByteArray &out)
+{
+    QElapsedTimer clock;
+    clock.start();
+    for (;;) {
+        const int idx = m_buffer.indexOf(marker);
+        if (idx >= 0) {
+            out = m_buffer.left(idx);
+            int end = idx + marker.size();
+            while (end < m_buffer.size() && (m_buffer[end] == '\r' || m_buffer[end] == '\n')) ++end;
+            m_buffer.remove(0, end);
+            return true;
+        }
+
+        const int remaining = timeoutMs - int(clock.elapsed());
+        if (remaining <= 0 || m_proc->state() != QProcess::Running)
+            return false;
+        if (m_proc->waitForReadyRead(remaining))
+            m_buffer += m_proc->readAllStandardOutput();
+        else if (m_proc->state() != QProcess::Running)
+            m_buffer += m_proc->readAllStandardOutput(); // 退出前最后一点输出
+    }
+}
+
+// 每条命令一个哨兵：带上本进程 pid 和序号，避免和命令输出撞上
+QByteArray ShellCmdSession::nextMarker()
+{
+    return QByteArray("__MLIB_CMD_END_") + QByteArray::number(QCoreApplication::applicationPid())
+         + '_' + QByteArray::number(++m_seq) + "__";
+}
+
+void ShellCmdSession::stop()
+{
+    m_buffer.clear();
+    if (!m_proc) return;
+    if (m_proc->state() != QProcess::NotRunning) {
+        m_proc->kill();
+        m_proc->waitForFinished(1000);
+    }
+    m_proc.reset();
+}
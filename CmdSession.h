@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QByteArray>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <memory>
+
+class QObject;
+class QProcess;
+class QThread;
+
+// 命令执行层：给 NetshWlanReader 用，可以换成别的实现（测试里指向本地 /bin/sh）
+class ICmdSession
+{
+public:
+    virtual ~ICmdSession() = default;
+
+    // 执行一条命令，返回它的标准输出；超时 / 会话异常返回空串（同 NetshWlanReader::runCmd）
+    virtual QString run(const QString &cmd, int timeoutMs) = 0;
+};
+
+// 常驻壳进程：命令从 stdin 写进去，每条后面跟一句 echo 哨兵，stdout 按哨兵切成一条条回复。
+// 省掉每次 cmd /c 起进程的 30~100ms。
+// - 壳进程死了下一条命令自动重启；某条命令超时会杀掉整个壳（流已经对不齐了），同样下一条重启
+// - 壳进程固定在会话自己的工作线程上（QProcess 只能在创建它的线程上用）：任何线程调 run
+//   都转到工作线程执行、阻塞等结果，多线程调用因此串行，换线程调用也不会重启壳
+class ShellCmdSession : public ICmdSession
+{
+public:
+    struct Shell
+    {
+        QString     program;
+        QStringList arguments;
+        QByteArray  newline;     // 写命令用的行尾
+        QString     echoFormat;  // 输出哨兵的命令，%1 = 哨兵文本
+    };
+
+    // cmd /q：关回显（不输出提示符和命令本身）；启动横幅在握手时丢掉
+    static Shell windowsCmd();
+    static Shell posixShell(const QString &path = "/bin/sh");
+
+    explicit ShellCmdSession(const Shell &shell = windowsCmd());
+    ~ShellCmdSession() override;
+
+    QString run(const QString &cmd, int timeoutMs) override;
+
+    bool isAlive() const;
+    int  restartCount() const; // 壳进程重启次数（第一次启动不算）
+
+private:
+    // 在工作线程上执行 fn 并等它做完（本来就在工作线程上时直接调）
+    void callOnWorker(const std::function<void()> &fn) const;
+    QString runOnWorker(const QString &cmd, int timeoutMs);
+    bool ensureStarted(int timeoutMs);
+    bool readUntil(const QByteArray &marker, int timeoutMs, QByteArray &out);
+    QByteArray nextMarker();
+    void stop();
+
+    Shell m_shell;
+    mutable QMutex m_mutex;
+    QThread   *m_thread = nullptr;   // 工作线程，m_proc 属于它
+    QObject   *m_context = nullptr;  // 住在工作线程上，投递调用用
+    std::unique_ptr<QProcess> m_proc;
+    QByteArray m_buffer;     // 还没切走的 stdout
+    quint64    m_seq = 0;
+    int        m_starts = 0;
+};
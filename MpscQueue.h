@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <utility>
+
+// 多生产者单消费者无锁队列（Vyukov 侵入式 MPSC）
+// push：任意线程，一次 exchange + 一次 store，不会阻塞
+// pop ：只能由唯一的消费者线程调用；生产者正在入队的瞬间可能暂时取不到（返回 false），下次再取即可
+template <class T>
+class MpscQueue final {
+public:
+    MpscQueue()
+        : m_head(&m_stub)
+        , m_tail(&m_stub)
+    {
+        m_stub.next.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~MpscQueue() {
+        T tmp;
+        while (pop(tmp)) {}
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void push(T value) {
+        Node* n = new Node;
+        n->value = std::move(value);
+        pushNode(n);
+    }
+
+    bool pop(T& out) {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (!next) return false;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_tail = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        // tail 是最后一个节点：把 stub 放回去，才能把 tail 取走
+        if (tail != m_head.load(std::memory_order_acquire)) return false;
+        pushNode(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            out = std::move(tail->value);
+            delete tail;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void pushNode(Node* n) {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = m_head.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    std::atomic<Node*> m_head; // 生产端
+    Node* m_tail;              // 消费端
+    Node  m_stub;
+};
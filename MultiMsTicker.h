@@ -3,129 +3,328 @@
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QMetaObject>
+#include <QThreadPool>
+#include <QPair>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <climits>
+#include "TickerThread.h"
+#include "TickerStats.h"
+#include "MpscQueue.h"
 
+// MultiMsTicker::timeoutBatch 的一条记录（Burst 补发时同一个 id 可能出现多次）
+struct TickerTimeoutRecord {
+    int id = 0;
+    int deltaMs = 0;
+    int missed = 0;
+    qint64 lateNs = 0;
+};
+Q_DECLARE_METATYPE(TickerTimeoutRecord)
+
+// 线程模型：
+// - 控制接口（setTimerConfig/startTimer/stopTimer/removeTimer/startAll…）任意线程都能调，
+//   只更新一份配置镜像（查询接口读它），再把命令投进无锁 MPSC 队列，然后叫醒调度端
+// - 调度端（onWakeup / 调度线程，同一时刻只有一个）每次唤醒先把队列取空，再扫堆触发；
+//   timer 数组、堆、相位都只归调度端所有，触发路径上不拿任何锁
 class MultiMsTicker final : public QObject {
     Q_OBJECT
 public:
+    using Backend = TickerBackend;
+    using CatchUp = TickerCatchUp;
+    using Overlap = TickerOverlap;
+
     struct TimerConfig {
         int intervalMs = 10;     // 到点周期
         bool enabled = true;     // 是否启用该 ID
         bool oneShot = false;    // 一次触发后自动停用
+        qint64 intervalNs = 0;   // >0 时按 ns 周期，覆盖 intervalMs
+        // 锁相：到点时刻从起点按周期整倍数推进（origin + k*interval），唤醒晚了不累积漂移
+        // 不锁相（默认）：下一次 = 实际触发时刻 + 周期，晚多少就漂多少
+        bool phaseLocked = false;
+        CatchUp catchUp = CatchUp::Skip; // 锁相模式下错过整周期时的处理
+        // 宽容度：允许比到点时刻最多晚 slackMs 触发，好和别的 timer 凑到同一次唤醒里（只会晚，不会早）
+        // 只作用于按截止堆安排唤醒的模式（adaptiveWakeup 或 Thread 后端）；
+        // 默认的 EventLoop 轮询每 wakeupMs 醒一次、到点就触发，slackMs 不起作用
+        int slackMs = 0;
+        Overlap overlap = Overlap::Skip; // poolDispatch：上一次回调还没跑完时的处理
+        // 对齐组（0=不分组）：同组 timer 的节拍点都落在组起点 + k*周期上（隐含锁相），
+        // 周期成倍数关系的（10/20/50/100ms）就会在公共边界上一起到点
+        int alignGroup = 0;
     };
 
     struct GlobalConfig {
         int wakeupMs = 1;        // 全局唤醒周期（内部轮询）
         bool emitWake = false;   // 是否发射每次全局唤醒间隔
+        bool adaptiveWakeup = false; // 自适应唤醒：不按 wakeupMs 轮询，单次定时器直接睡到最早的到点时刻
+        // Thread：在独立调度线程上按绝对到点时刻（ns）触发，忽略 wakeupMs/adaptiveWakeup；
+        // timeout 等信号从调度线程发出，连到其他线程的对象时自动走 queued 连接
+        Backend backend = Backend::EventLoop;
+        int threadPriority = 0;  // Thread 后端：>0 为 SCHED_FIFO 优先级（1~99），需要权限
+        bool collectStats = false; // 统计每个 id 的触发延迟直方图、超时/错过计数，以及每次唤醒扫描的耗时
+        // collectStats 下是否给每个 id 单独分配直方图（每个约 5KB）；timer 上万时可以关掉，只看 latenessStats()
+        bool perTimerStats = true;
+        // 批量投递：一次唤醒里到点的所有 id 合成一个 timeoutBatch 信号，不再逐个发 timeout/ticksMissed
+        // （回调仍逐条调用；批量模式下不统计单个 id 的处理超时）
+        bool batchTimeouts = false;
+        // 线程池执行：到点后回调和 timeout/ticksMissed 都放到线程池里跑（信号从池线程发出），
+        // 调度端只负责投递，慢槽函数不会拖累后面的 timer；打开后 batchTimeouts 不生效
+        bool poolDispatch = false;
+    };
+
+    using TimeoutRecord = TickerTimeoutRecord;
+
+    // 线程池执行的统计
+    struct DispatchStats {
+        quint64 dispatched = 0;  // 投递到线程池的次数
+        quint64 overlapped = 0;  // 到点时上一次还在跑（或还在排队）的次数
+        quint64 skipped = 0;     // 其中按 Overlap::Skip 丢掉的次数
     };
 
+    // 合并唤醒的效果：wakeups = 触发过 timer 的唤醒次数；
+    // savedWakeups = 靠宽容度提前搭了别人唤醒的触发次数（这次唤醒时自己的截止时刻还没到），不合并的话这些都要单独醒一次；
+    // 同一次扫描里本来就都到了截止时刻的、Burst 补发的第二拍起都不算，EventLoop 轮询模式下恒为 0
+    struct CoalesceStats {
+        quint64 wakeups = 0;
+        quint64 savedWakeups = 0;
+    };
+
+    // 到点回调：直接在触发线程上调用（Thread 后端即调度线程），先于 timeout 信号；startAll 之前设置
+    // missed = 本次合并掉的周期数（仅锁相 + Coalesce 时非 0）
+    // lateNs = 实际触发比这一拍的节拍时刻晚了多少（锁相合并时按合并后最近的一拍算）；
+    //          调用方要“到点时刻”就用自己的时钟减掉它，不要拿回调被调用的时刻代替
+    using TimeoutCallback = std::function<void(int id, int deltaMs, int missed, qint64 lateNs)>;
+
     explicit MultiMsTicker(QObject* parent = nullptr)
         : QObject(parent)
     {
         m_wakeupTimer.setTimerType(Qt::PreciseTimer);
         m_wakeupTimer.setSingleShot(false);
         connect(&m_wakeupTimer, &QTimer::timeout, this, &MultiMsTicker::onWakeup);
+        qRegisterMetaType<QVector<TickerTimeoutRecord> >("QVector<TickerTimeoutRecord>");
+        // 时钟从构造开始走：命令在任何线程投递时都能带上时刻
+        m_elapsed.start();
+    }
+
+    ~MultiMsTicker() override {
+        if (m_thread) m_thread->stopAndWait();
+        // 线程池里还在跑的回调会用到 this
+        while (m_poolTasks.load() > 0) QThread::msleep(1);
+    }
+
+    // poolDispatch 用的线程池（nullptr = QThreadPool::globalInstance()）；不接管所有权
+    void setThreadPool(QThreadPool* pool) {
+        m_pool.store(pool);
+    }
+
+    void setTimeoutCallback(TimeoutCallback fn) {
+        QMutexLocker lock(&m_ctlMutex);
+        m_callback = std::move(fn);
     }
 
     // ---------- 默认参数 ----------
     void setDefaultTimerConfig(const TimerConfig& cfg) {
+        QMutexLocker lock(&m_ctlMutex);
         m_defaultCfg = normalizeTimerCfg(cfg);
     }
-    TimerConfig defaultTimerConfig() const { return m_defaultCfg; }
+    TimerConfig defaultTimerConfig() const {
+        QMutexLocker lock(&m_ctlMutex);
+        return m_defaultCfg;
+    }
 
     void setGlobalConfig(const GlobalConfig& cfg) {
+        QMutexLocker lock(&m_ctlMutex);
         m_globalCfg = normalizeGlobalCfg(cfg);
-        if (m_wakeupTimer.isActive()) {
-            // 运行中修改唤醒周期：立即生效
-            m_wakeupTimer.start(m_globalCfg.wakeupMs);
+        m_backend.store(int(m_globalCfg.backend));
+        postLocked(Command::Global, 0, nullptr);
+        if (m_running.load()) {
+            // 运行中修改唤醒周期/模式/后端：立即生效
+            startWakeupLocked();
         }
     }
-    GlobalConfig globalConfig() const { return m_globalCfg; }
+    GlobalConfig globalConfig() const {
+        QMutexLocker lock(&m_ctlMutex);
+        return m_globalCfg;
+    }
 
     // ---------- 管理定时器 ----------
     // 创建或更新：若该 id 不存在，则以默认参数创建，再用 cfg 覆盖
     void setTimerConfig(int id, const TimerConfig& cfg) {
-        TimerItem& it = ensureItem(id);
-        it.cfg = normalizeTimerCfg(cfg);
+        QMutexLocker lock(&m_ctlMutex);
+        MirrorItem& it = mirrorItem(id);
+        const TimerConfig c = normalizeTimerCfg(cfg);
+        setMirrorEnabled(it, c.enabled);
+        it.cfg = c;
         // 若 interval 改小/改大，我们不强制重置相位；需要时你可以 reset(id)
+        postLocked(Command::Upsert, id, &it);
     }
 
     // 只改 interval（最常用）
     void setIntervalMs(int id, int intervalMs) {
-        TimerItem& it = ensureItem(id);
+        QMutexLocker lock(&m_ctlMutex);
+        MirrorItem& it = mirrorItem(id);
         it.cfg.intervalMs = (intervalMs < 1) ? 1 : intervalMs;
+        it.cfg.intervalNs = 0;
+        postLocked(Command::Upsert, id, &it);
+    }
+
+    // ns 周期（锁相模式下做高精度节拍用）
+    void setIntervalNs(int id, qint64 intervalNs) {
+        QMutexLocker lock(&m_ctlMutex);
+        MirrorItem& it = mirrorItem(id);
+        TimerConfig c = it.cfg;
+        c.intervalNs = intervalNs;
+        it.cfg = normalizeTimerCfg(c);
+        postLocked(Command::Upsert, id, &it);
     }
 
     // 获取配置（不存在则返回默认）
     TimerConfig timerConfig(int id) const {
-        if (!m_items.contains(id)) return m_defaultCfg;
-        return m_items.value(id).cfg;
+        QMutexLocker lock(&m_ctlMutex);
+        const auto found = m_mirror.constFind(id);
+        if (found == m_mirror.constEnd()) return m_defaultCfg;
+        return found->cfg;
     }
 
     // 启用/停用某个 id（不会删除）
     void startTimer(int id) {
-        TimerItem& it = ensureItem(id);
-        it.cfg.enabled = true;
-
-        if (m_elapsed.isValid()) {
-            const qint64 now = m_elapsed.nsecsElapsed();
-            if (it.lastFireNs == 0) it.lastFireNs = now;
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            MirrorItem& it = mirrorItem(id);
+            setMirrorEnabled(it, true);
+            postLocked(Command::Start, id, &it);
+            ensureRunningLocked();
         }
-        ensureWakeupRunning();
         emit timerStarted(id);
     }
 
     void stopTimer(int id) {
-        if (!m_items.contains(id)) return;
-        TimerItem& it = m_items[id];
-        it.cfg.enabled = false;
-        emit timerStopped(id);
+        bool stoppedAll = false;
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            const auto found = m_mirror.find(id);
+            if (found == m_mirror.end()) return;
+            setMirrorEnabled(*found, false);
+            postLocked(Command::Upsert, id, &*found);
 
-        // 如果全部都停了，可选择自动停全局唤醒
-        if (!anyEnabled()) {
-            stopAll();
+            // 如果全部都停了，可选择自动停全局唤醒
+            stoppedAll = m_mirrorEnabled == 0 && stopLocked();
         }
+        emit timerStopped(id);
+        if (stoppedAll) emit stopped();
     }
 
     // 删除某个 id（连状态一起删）
     void removeTimer(int id) {
-        if (!m_items.contains(id)) return;
-        const bool wasEnabled = m_items.value(id).cfg.enabled;
-        m_items.remove(id);
-        emit timerRemoved(id);
-
-        if (wasEnabled && !anyEnabled()) {
-            stopAll();
+        bool stoppedAll = false;
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            const auto found = m_mirror.find(id);
+            if (found == m_mirror.end()) return;
+            const bool wasEnabled = found->cfg.enabled;
+            setMirrorEnabled(*found, false);
+            m_mirror.erase(found);
+            postLocked(Command::Remove, id, nullptr);
+            stoppedAll = wasEnabled && m_mirrorEnabled == 0 && stopLocked();
         }
+        emit timerRemoved(id);
+        if (stoppedAll) emit stopped();
     }
 
-    bool hasTimer(int id) const { return m_items.contains(id); }
+    bool hasTimer(int id) const {
+        QMutexLocker lock(&m_ctlMutex);
+        return m_mirror.contains(id);
+    }
 
-    // 重置相位：从现在开始重新计时（下一次 intervalMs 后触发）
+    // 重置相位：从现在开始重新计时（下一次 intervalMs 后触发；锁相模式的起点也移到现在）
     void resetTimer(int id) {
-        if (!m_items.contains(id)) return;
-        if (!m_elapsed.isValid()) return;
-        m_items[id].lastFireNs = m_elapsed.nsecsElapsed();
+        QMutexLocker lock(&m_ctlMutex);
+        const auto found = m_mirror.find(id);
+        if (found == m_mirror.end()) return;
+        postLocked(Command::Reset, id, &*found);
     }
 
     // ---------- 全局启动/停止 ----------
-    bool isRunning() const { return m_wakeupTimer.isActive(); }
+    bool isRunning() const {
+        return m_running.load();
+    }
+
+    // ---------- 统计（collectStats 打开后才记录；不用停 ticker，任意线程随时取） ----------
+    // 某个 id 的触发延迟（实际触发 - 理论到点，ns）分位数、处理超时次数、错过周期数；reset=true 取完清零
+    TickerStats::Snapshot timerStats(int id, bool reset = false) {
+        std::shared_ptr<TickerStats> st;
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            const auto found = m_mirror.constFind(id);
+            if (found != m_mirror.constEnd()) st = found->stats;
+        }
+        return st ? st->snapshot(reset) : TickerStats::Snapshot();
+    }
+
+    // 所有 timer 合在一起的触发延迟、处理超时、错过周期（看整体，timer 很多时不用逐个取）
+    TickerStats::Snapshot latenessStats(bool reset = false) {
+        return m_allStats.snapshot(reset);
+    }
+
+    // 每次唤醒扫描本身的耗时（不含槽函数/回调）
+    TickerStats::Snapshot wakeupStats(bool reset = false) {
+        return m_wakeStats.snapshot(reset);
+    }
+
+    // 汇总多个 ticker（分片）用：把合计延迟 / 唤醒耗时累加到 dst
+    void mergeLatenessStats(TickerStats& dst, bool reset = false) {
+        m_allStats.mergeInto(dst, reset);
+    }
+    void mergeWakeupStats(TickerStats& dst, bool reset = false) {
+        m_wakeStats.mergeInto(dst, reset);
+    }
+
+    DispatchStats dispatchStats(bool reset = false) {
+        DispatchStats s;
+        s.dispatched = reset ? m_dispatched.exchange(0, std::memory_order_relaxed)
+                             : m_dispatched.load(std::memory_order_relaxed);
+        s.overlapped = reset ? m_overlapped.exchange(0, std::memory_order_relaxed)
+                             : m_overlapped.load(std::memory_order_relaxed);
+        s.skipped = reset ? m_skipped.exchange(0, std::memory_order_relaxed)
+                          : m_skipped.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // 合并唤醒统计（一直记录，reset=true 取完清零）
+    CoalesceStats coalesceStats(bool reset = false) {
+        CoalesceStats s;
+        s.wakeups = reset ? m_firingWakeups.exchange(0, std::memory_order_relaxed)
+                          : m_firingWakeups.load(std::memory_order_relaxed);
+        s.savedWakeups = reset ? m_savedWakeups.exchange(0, std::memory_order_relaxed)
+                               : m_savedWakeups.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    // Thread 后端下调度线程是否拿到了 SCHED_FIFO
+    bool isRealtime() const {
+        QMutexLocker lock(&m_ctlMutex);
+        return m_thread && m_thread->isRealtime();
+    }
 
 public slots:
     void startAll() {
-        ensureWakeupRunning();
-        // 把所有 enabled 的 timer 初始化 lastFireNs（避免刚 start 立即触发）
-        const qint64 now = m_elapsed.nsecsElapsed();
-        for (auto it = m_items.begin(); it != m_items.end(); ++it) {
-            if (it.value().cfg.enabled && it.value().lastFireNs == 0) {
-                it.value().lastFireNs = now;
-            }
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            // 把所有 enabled 的 timer 初始化起始相位（避免刚 start 立即触发）
+            postLocked(Command::StartAll, 0, nullptr);
+            ensureRunningLocked();
         }
         emit started();
     }
 
     void stopAll() {
-        if (!m_wakeupTimer.isActive()) return;
-        m_wakeupTimer.stop();
+        {
+            QMutexLocker lock(&m_ctlMutex);
+            if (!stopLocked()) return;
+        }
         emit stopped();
     }
 
@@ -143,106 +342,739 @@ signals:
     // 到点触发：deltaMs = 距离该 id 上次触发的真实间隔（ms）
     void timeout(int id, int deltaMs);
 
+    // 锁相 + Coalesce：这次 timeout 合并掉了 missed 个周期（紧接着发 timeout）
+    void ticksMissed(int id, int missed);
+
+    // batchTimeouts：本次唤醒到点的全部记录，按触发顺序连续存放
+    // 直连时缓冲在唤醒之间复用；queued 连接拿到的是隐式共享的同一份数据，不逐条拷贝
+    void timeoutBatch(const QVector<TickerTimeoutRecord>& records);
+
 private slots:
     void onWakeup() {
-        if (!m_elapsed.isValid()) return;
+        processDue(true);
+    }
 
-        const qint64 nowNs = m_elapsed.nsecsElapsed();
+private:
+    // ---------- 命令（控制端 -> 调度端） ----------
+    // 带完整的配置快照和投递时刻，调度端按队列顺序照做即可，不回头读镜像
+    struct Command {
+        enum Type { Upsert, Start, Reset, Remove, StartAll, Global };
+        Type type = Upsert;
+        int id = 0;
+        quint64 seq = 0;     // 投递序号：单发结束时用来判断镜像有没有被更新的命令覆盖
+        qint64 atNs = 0;     // 投递时刻（Start/Reset/StartAll 的起始相位）
+        TimerConfig cfg;
+        GlobalConfig global;
+    };
+
+    // 控制端的配置镜像（m_ctlMutex 保护）
+    struct MirrorItem {
+        TimerConfig cfg;
+        quint64 seq = 0;     // 最后一条关于该 id 的命令
+        std::shared_ptr<TickerStats> stats; // 调度端第一次统计时发布过来
+    };
+
+    // 线程池执行：一个 timer 的在途状态，调度端和池线程共享（timer 删掉后由在途任务持有到结束）
+    struct DispatchRun {
+        int deltaMs = 0;
+        int missed = 0;
+        qint64 lateNs = 0;
+    };
+    struct DispatchState {
+        Overlap overlap = Overlap::Skip;  // 创建时定下，策略改了就换一个新的
+        std::atomic<int> inFlight{0};     // 在跑 + 排队的次数
+        MpscQueue<DispatchRun> queue;     // Queue 策略的待跑队列（调度端生产，当前在跑的任务消费）
+    };
+
+    // 调度端的 timer
+    struct TimerItem {
+        int id = 0;
+        TimerConfig cfg;
+        quint64 seq = 0;       // 已应用的最后一条命令
+        qint64 lastFireNs = 0; // 上次触发时刻（单调 ns）
+        qint64 gridNs = 0;     // 锁相模式：上一个节拍点（起点 + k*周期）
+        std::shared_ptr<TickerStats> stats; // collectStats 打开后第一次触发时分配
+        std::shared_ptr<DispatchState> dispatch; // poolDispatch 第一次投递时分配
+        qint64 dueNs = 0;      // 下次到点时刻（单调 ns）
+        qint64 deadlineNs = 0; // 最晚触发时刻 = dueNs + slack
+        int heapPos = -1;      // 在到点堆中的位置，-1=不在堆里
+        int deadlinePos = -1;  // 在截止堆中的位置
+    };
+
+    // 两个最小堆共用同一套操作，元素为 m_items 下标：
+    // 到点堆（按 dueNs）决定这次唤醒触发谁，截止堆（按 deadlineNs）决定下一次什么时候醒
+    struct HeapIndex {
+        QVector<int> heap;
+        qint64 TimerItem::*key;
+        int TimerItem::*pos;
+    };
+
+    static constexpr qint64 kBusy = -2; // processDue：调度端正被占用（重入 / 切换后端的瞬间）
+
+    // 处理一次唤醒：两种后端共用，返回下一次最晚要醒的时刻（截止堆顶，-1=堆空）
+    // 醒来后所有已到点的都一起触发：宽容度内没被逼着醒的 timer 就搭这次唤醒的车
+    // 槽函数/回调里随便调控制接口（包括 stop/remove 自己），改动作为命令在每次 emit 之后取出生效；
+    // 每次都重新取堆顶，不持有引用跨 emit
+    qint64 processDue(bool fromEventLoop) {
+        // 同一时刻只能有一个调度端；acquire/release 也把调度端状态在线程间交接（切换后端时）
+        if (m_inScheduler.exchange(true, std::memory_order_acquire)) return kBusy;
+
+        drainCommands();
+        if (!m_running.load()) {
+            m_inScheduler.store(false, std::memory_order_release);
+            return -1;
+        }
+
+        const qint64 nowNs = nowNsec();
+        const bool collect = m_schedCfg.collectStats;
+        const bool pool = m_schedCfg.poolDispatch;
+        const bool batch = m_schedCfg.batchTimeouts && !pool;
+        qint64 handlerNs = 0; // 槽函数/回调耗时，从扫描耗时里扣掉
+
+        // 批量模式：借出复用缓冲
+        QVector<TimeoutRecord> records;
+        QVector<QPair<int, quint64> > stoppedIds; // 单发结束：id + 当时已应用的命令序号
+        if (batch) {
+            records.swap(m_batch);
+            records.resize(0);
+        }
 
         // 全局唤醒间隔（可选）
-        if (m_globalCfg.emitWake) {
+        if (m_schedCfg.emitWake) {
             int wakeDeltaMs = int((nowNs - m_lastWakeNs) / 1000000);
             if (wakeDeltaMs < 0) wakeDeltaMs = 0;
             emit wake(wakeDeltaMs);
+            if (collect) handlerNs += nowNsec() - nowNs;
+            drainCommands();
         }
         m_lastWakeNs = nowNs;
 
-        // 扫描所有 enabled 的 timer：到点就触发一次（不补帧）
-        const qint64 nowMsNs = nowNs; // just naming
-        for (auto it = m_items.begin(); it != m_items.end(); ++it) {
-            TimerItem& item = it.value();
-            if (!item.cfg.enabled) continue;
+        // 只处理堆顶已到点的 timer：到点就触发一次（不补帧）
+        // 合并只在按截止堆唤醒时才有意义：轮询模式的唤醒跟 timer 无关
+        const bool deadlineWake = !fromEventLoop || m_schedCfg.adaptiveWakeup;
+        int fired = 0;
+        int saved = 0;
+        while (!m_dueHeap.heap.isEmpty()) {
+            const int slot = m_dueHeap.heap.first();
+            TimerItem& item = m_items[slot];
+            if (item.dueNs > nowNs) break;
 
+            // 还没有起始相位：从这次唤醒开始计时，本次不触发
             if (item.lastFireNs == 0) {
-                // 第一次运行：从现在开始计时
-                item.lastFireNs = nowMsNs;
+                startPhase(item, nowNs);
+                schedule(slot);
                 continue;
             }
 
-            const qint64 sinceFireNs = nowMsNs - item.lastFireNs;
-            if (sinceFireNs < 0) continue;
+            const int id = item.id;
+            const int deltaMs = int((nowNs - item.lastFireNs) / 1000000);
+            const bool oneShot = item.cfg.oneShot;
+            const quint64 seq = item.seq;
+            const qint64 period = periodNs(item.cfg);
+            ++fired;
+            // 截止时刻还没到 = 被别的 timer 的唤醒顺带提前触发；lastFireNs == nowNs 是本轮 Burst 补发
+            if (deadlineWake && item.deadlineNs > nowNs && item.lastFireNs != nowNs) ++saved;
 
-            const qint64 intervalNs = qint64(item.cfg.intervalMs) * 1000000LL;
-            if (sinceFireNs >= intervalNs) {
-                const int deltaMs = int(sinceFireNs / 1000000);
-                item.lastFireNs = nowMsNs;
+            // 统计要在推进到点时刻之前记
+            TickerStats* st = nullptr;
+            if (collect) {
+                const qint64 lateNs = nowNs - item.dueNs;
+                const quint64 missedTicks =
+                    (isLocked(item.cfg) && item.cfg.catchUp == CatchUp::Burst) ? 0 : quint64(lateNs / period);
+                m_allStats.record(lateNs);
+                m_allStats.addMissed(missedTicks);
+                if (m_schedCfg.perTimerStats) {
+                    if (!item.stats) publishStats(item);
+                    st = item.stats.get();
+                    st->record(lateNs);
+                    st->addMissed(missedTicks);
+                }
+            }
+
+            const qint64 dueNs = item.dueNs;
+            const int missed = advancePhase(item, nowNs);
+            // 这一拍的节拍时刻：锁相的是推进后的节拍点，不锁相的就是到点时刻
+            const qint64 tickLateNs = nowNs - (isLocked(item.cfg) ? item.gridNs : dueNs);
+            item.lastFireNs = nowNs;
+            if (oneShot) {
+                setEnabled(slot, false);
+            }
+            schedule(slot);
+
+            if (pool) {
+                dispatch(item, deltaMs, missed, tickLateNs, period,
+                         collect ? item.stats : std::shared_ptr<TickerStats>(), collect);
+                if (oneShot) {
+                    finishOneShot(id, seq);
+                    emit timerStopped(id);
+                }
+                if (m_kickPending.load(std::memory_order_relaxed)) drainCommands();
+                continue;
+            }
 
-                emit timeout(it.key(), deltaMs);
+            if (batch) {
+                TimeoutRecord r;
+                r.id = id;
+                r.deltaMs = deltaMs;
+                r.missed = missed;
+                r.lateNs = tickLateNs;
+                records.append(r);
+                if (oneShot) stoppedIds.append(qMakePair(id, seq));
+                continue;
+            }
 
-                if (item.cfg.oneShot) {
-                    item.cfg.enabled = false;
-                    emit timerStopped(it.key());
+            const qint64 t0 = collect ? nowNsec() : 0;
+            if (m_callback) m_callback(id, deltaMs, missed, tickLateNs);
+            if (missed > 0) emit ticksMissed(id, missed);
+            emit timeout(id, deltaMs);
+            if (oneShot) {
+                finishOneShot(id, seq);
+                emit timerStopped(id);
+            }
+            if (collect) {
+                const qint64 spentNs = nowNsec() - t0;
+                handlerNs += spentNs;
+                if (spentNs > period) {
+                    if (st) st->addOverrun();
+                    m_allStats.addOverrun();
                 }
             }
+            // 槽函数里投的命令（停掉/删掉还没轮到的 timer 等）本轮就生效
+            if (m_kickPending.load(std::memory_order_relaxed)) drainCommands();
         }
 
+        if (!records.isEmpty()) {
+            const qint64 t0 = collect ? nowNsec() : 0;
+            if (m_callback) {
+                for (const TimeoutRecord& r : records) m_callback(r.id, r.deltaMs, r.missed, r.lateNs);
+            }
+            emit timeoutBatch(records);
+            for (const QPair<int, quint64>& s : stoppedIds) {
+                finishOneShot(s.first, s.second);
+                emit timerStopped(s.first);
+            }
+            if (collect) handlerNs += nowNsec() - t0;
+        }
+        if (batch) {
+            m_batch.swap(records);
+        }
+
+        if (collect) {
+            m_wakeStats.record(nowNsec() - nowNs - handlerNs);
+        }
+        if (fired > 0) {
+            m_firingWakeups.fetch_add(1, std::memory_order_relaxed);
+            if (saved > 0) m_savedWakeups.fetch_add(quint64(saved), std::memory_order_relaxed);
+        }
+
+        drainCommands();
+        const qint64 dueNs = m_deadlineHeap.heap.isEmpty() ? -1 : m_items[m_deadlineHeap.heap.first()].deadlineNs;
         // 如果没有任何 enabled 的 timer，自动停全局唤醒（可选行为：这里直接停）
-        if (!anyEnabled()) {
-            stopAll();
+        const bool idle = m_enabledCount == 0;
+        if (!idle && fromEventLoop) rearm(dueNs);
+        m_inScheduler.store(false, std::memory_order_release);
+
+        if (idle && autoStop()) emit stopped();
+        return dueNs;
+    }
+
+    // 调度线程上执行：处理到点的 timer，返回距堆顶到点的 ns（<0 = 无事可做，睡到被唤醒）
+    qint64 threadTick() {
+        // 运行中切回 EventLoop 后，调度线程不再处理
+        if (!m_running.load() || m_backend.load() != int(Backend::Thread)) return -1;
+        const qint64 dueNs = processDue(false);
+        if (dueNs == kBusy) return 1000000; // 另一个调度端还没退出，1ms 后再来
+        if (dueNs < 0 || !m_running.load() || m_backend.load() != int(Backend::Thread)) return -1;
+        const qint64 remainNs = dueNs - nowNsec();
+        return remainNs > 0 ? remainNs : 0;
+    }
+
+    // ---------- 调度端：命令 ----------
+    // 先清掉“已叫醒”标记再取队列：清完之后投进来的命令会重新叫醒，不会漏
+    void drainCommands() {
+        m_kickPending.exchange(false, std::memory_order_acq_rel);
+        Command cmd;
+        while (m_commands.pop(cmd)) applyCommand(cmd);
+    }
+
+    void applyCommand(const Command& cmd) {
+        if (cmd.type == Command::Global) {
+            m_schedCfg = cmd.global;
+            m_armedDueNs = -1;
+            return;
+        }
+        if (cmd.type == Command::StartAll) {
+            for (int slot = 0; slot < m_items.size(); ++slot) {
+                TimerItem& it = m_items[slot];
+                if (it.cfg.enabled && it.lastFireNs == 0) {
+                    startPhase(it, cmd.atNs);
+                    schedule(slot);
+                }
+            }
+            return;
+        }
+
+        int slot = m_index.value(cmd.id, -1);
+        if (cmd.type == Command::Remove) {
+            if (slot >= 0) eraseItem(slot);
+            return;
+        }
+        if (slot < 0) {
+            if (cmd.type == Command::Reset) return;
+            slot = addItem(cmd.id);
+        }
+
+        TimerItem& it = m_items[slot];
+        it.seq = cmd.seq;
+        if (cmd.type == Command::Reset) {
+            startPhase(it, cmd.atNs);
+        } else {
+            setEnabled(slot, cmd.cfg.enabled);
+            const TimerConfig old = it.cfg;
+            it.cfg = cmd.cfg;
+            if (it.dispatch && it.dispatch->overlap != it.cfg.overlap) it.dispatch.reset();
+            if (it.lastFireNs != 0) {
+                // 换了对齐组：以上一次触发为准对齐到组的节拍上；打开锁相：以上一次触发为起点
+                if (cmd.cfg.alignGroup != 0 && cmd.cfg.alignGroup != old.alignGroup) {
+                    startPhase(it, it.lastFireNs);
+                } else if (isLocked(cmd.cfg) && !isLocked(old)) {
+                    it.gridNs = it.lastFireNs;
+                }
+            }
+            if (cmd.type == Command::Start && it.lastFireNs == 0) startPhase(it, cmd.atNs);
         }
+        schedule(slot);
     }
 
-private:
-    struct TimerItem {
-        TimerConfig cfg;
-        qint64 lastFireNs = 0; // 上次触发时刻（单调 ns）
-    };
+    // ---------- 线程池执行 ----------
+    // 调度端调用：按该 timer 的 Overlap 策略投递一次；只做原子操作和 QThreadPool::start，不等回调
+    void dispatch(TimerItem& item, int deltaMs, int missed, qint64 lateNs, qint64 period,
+                  const std::shared_ptr<TickerStats>& st, bool collect) {
+        if (!item.dispatch) {
+            item.dispatch = std::make_shared<DispatchState>();
+            item.dispatch->overlap = item.cfg.overlap;
+        }
+        const std::shared_ptr<DispatchState> ds = item.dispatch;
+        const int id = item.id;
+        DispatchRun run;
+        run.deltaMs = deltaMs;
+        run.missed = missed;
+        run.lateNs = lateNs;
 
+        if (ds->inFlight.load(std::memory_order_acquire) > 0) {
+            m_overlapped.fetch_add(1, std::memory_order_relaxed);
+        }
+        switch (ds->overlap) {
+        case Overlap::Skip: {
+            int idle = 0;
+            if (!ds->inFlight.compare_exchange_strong(idle, 1, std::memory_order_acq_rel)) {
+                m_skipped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            startPoolTask([this, ds, id, run, period, st, collect] {
+                runHandler(id, run, period, st.get(), collect);
+                ds->inFlight.fetch_sub(1, std::memory_order_release);
+            });
+            break;
+        }
+        case Overlap::Concurrent:
+            ds->inFlight.fetch_add(1, std::memory_order_acq_rel);
+            startPoolTask([this, ds, id, run, period, st, collect] {
+                runHandler(id, run, period, st.get(), collect);
+                ds->inFlight.fetch_sub(1, std::memory_order_release);
+            });
+            break;
+        case Overlap::Queue:
+            // 先入队再计数：计数从 0 变 1 的那次负责起任务，任务把队列跑空、计数归零才退出，
+            // 所以同一时刻只有一个任务在消费
+            ds->queue.push(run);
+            if (ds->inFlight.fetch_add(1, std::memory_order_acq_rel) != 0) break;
+            startPoolTask([this, ds, id, period, st, collect] {
+                for (;;) {
+                    DispatchRun next;
+                    while (!ds->queue.pop(next)) QThread::yieldCurrentThread(); // 入队的一瞬间
+                    runHandler(id, next, period, st.get(), collect);
+                    if (ds->inFlight.fetch_sub(1, std::memory_order_acq_rel) == 1) break;
+                }
+            });
+            break;
+        }
+        m_dispatched.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <class Fn>
+    void startPoolTask(Fn fn) {
+        QThreadPool* pool = m_pool.load();
+        if (!pool) pool = QThreadPool::globalInstance();
+        m_poolTasks.fetch_add(1);
+        pool->start([this, fn] {
+            fn();
+            m_poolTasks.fetch_sub(1);
+        });
+    }
+
+    // 池线程上执行：回调 + 信号；处理耗时超过周期记一次超时
+    void runHandler(int id, const DispatchRun& run, qint64 period, TickerStats* st, bool collect) {
+        const qint64 t0 = collect ? nowNsec() : 0;
+        if (m_callback) m_callback(id, run.deltaMs, run.missed, run.lateNs);
+        if (run.missed > 0) emit ticksMissed(id, run.missed);
+        emit timeout(id, run.deltaMs);
+        if (collect && nowNsec() - t0 > period) {
+            if (st) st->addOverrun();
+            m_allStats.addOverrun();
+        }
+    }
+
+    // 单发触发完：镜像里没有更新的命令时同步成停用（有的话以那条命令为准）
+    void finishOneShot(int id, quint64 seq) {
+        QMutexLocker lock(&m_ctlMutex);
+        const auto found = m_mirror.find(id);
+        if (found == m_mirror.end() || found->seq != seq) return;
+        setMirrorEnabled(*found, false);
+    }
+
+    // 第一次统计时分配，并发布到镜像供 timerStats() 读（每个 id 只走一次锁）
+    void publishStats(TimerItem& item) {
+        item.stats = std::make_shared<TickerStats>();
+        QMutexLocker lock(&m_ctlMutex);
+        const auto found = m_mirror.find(item.id);
+        if (found != m_mirror.end() && !found->stats) found->stats = item.stats;
+    }
+
+    // 调度端已经没有启用的 timer：镜像里也没有（没有还在路上的命令）才真的停
+    bool autoStop() {
+        QMutexLocker lock(&m_ctlMutex);
+        return m_mirrorEnabled == 0 && stopLocked();
+    }
+
+    // ---------- 调度端：timer 与堆 ----------
     TimerConfig normalizeTimerCfg(TimerConfig c) const {
         if (c.intervalMs < 1) c.intervalMs = 1;
+        if (c.intervalNs < 0) c.intervalNs = 0;
+        if (c.intervalNs > 0 && c.intervalNs < kMinIntervalNs) c.intervalNs = kMinIntervalNs;
+        if (c.slackMs < 0) c.slackMs = 0;
         return c;
     }
+
+    // 对齐组隐含锁相，否则一次晚唤醒就把它从组的节拍上带偏了
+    static bool isLocked(const TimerConfig& c) {
+        return c.phaseLocked || c.alignGroup != 0;
+    }
+
+    static qint64 periodNs(const TimerConfig& c) {
+        return c.intervalNs > 0 ? c.intervalNs : qint64(c.intervalMs) * 1000000LL;
+    }
+
+    // 对齐组的节拍点取不超过 nowNs 的 组起点 + k*周期，组起点是组里第一个起算的 timer 的时刻
+    void startPhase(TimerItem& item, qint64 nowNs) {
+        item.lastFireNs = nowNs;
+        item.gridNs = nowNs;
+        if (item.cfg.alignGroup == 0) return;
+        auto origin = m_groupOrigin.find(item.cfg.alignGroup);
+        if (origin == m_groupOrigin.end()) origin = m_groupOrigin.insert(item.cfg.alignGroup, nowNs);
+        const qint64 period = periodNs(item.cfg);
+        item.gridNs = *origin + (nowNs - *origin) / period * period;
+    }
+
+    // 锁相模式下把节拍点推进到下一个未来时刻，返回要报告的错过周期数
+    // Skip/Coalesce：一次跳过所有已错过的节拍（Coalesce 报告个数）；Burst：只推进一拍，还到点就接着补发
+    static int advancePhase(TimerItem& item, qint64 nowNs) {
+        if (!isLocked(item.cfg)) return 0;
+        const qint64 period = periodNs(item.cfg);
+        if (item.cfg.catchUp == CatchUp::Burst) {
+            item.gridNs += period;
+            return 0;
+        }
+        const qint64 ticks = (nowNs - item.gridNs) / period; // >=1：已到点
+        item.gridNs += ticks * period;
+        if (item.cfg.catchUp != CatchUp::Coalesce || ticks <= 1) return 0;
+        return int(qMin<qint64>(ticks - 1, INT_MAX));
+    }
     GlobalConfig normalizeGlobalCfg(GlobalConfig c) const {
         if (c.wakeupMs < 1) c.wakeupMs = 1;
         return c;
     }
 
-    TimerItem& ensureItem(int id) {
-        if (!m_items.contains(id)) {
-            TimerItem item;
+    // 新建一个停用的 timer，返回下标（配置由紧接着的命令给）
+    int addItem(int id) {
+        TimerItem item;
+        item.id = id;
+        item.cfg.enabled = false;
+        const int slot = m_items.size();
+        m_items.append(item);
+        m_index.insert(id, slot);
+        return slot;
+    }
+
+    // 删除：与最后一个元素交换后弹出，保持数组稠密
+    void eraseItem(int slot) {
+        if (m_items[slot].heapPos >= 0) {
+            heapRemove(m_dueHeap, slot);
+            heapRemove(m_deadlineHeap, slot);
+        }
+        setEnabled(slot, false);
+        m_index.remove(m_items[slot].id);
+
+        const int last = m_items.size() - 1;
+        if (slot != last) {
+            m_items[slot] = m_items[last];
+            m_index[m_items[slot].id] = slot;
+            if (m_items[slot].heapPos >= 0) {
+                m_dueHeap.heap[m_items[slot].heapPos] = slot;
+                m_deadlineHeap.heap[m_items[slot].deadlinePos] = slot;
+            }
+        }
+        m_items.removeLast();
+    }
+
+    void setEnabled(int slot, bool enabled) {
+        TimerItem& item = m_items[slot];
+        if (item.cfg.enabled == enabled) return;
+        item.cfg.enabled = enabled;
+        m_enabledCount += enabled ? 1 : -1;
+    }
+
+    // 按当前配置把 timer 放进 / 移出两个堆（O(log n)）
+    // 未启用的不进堆；还没有起始相位的排在堆顶，下次唤醒时再起算
+    void schedule(int slot) {
+        TimerItem& item = m_items[slot];
+        if (!item.cfg.enabled) {
+            if (item.heapPos >= 0) {
+                heapRemove(m_dueHeap, slot);
+                heapRemove(m_deadlineHeap, slot);
+            }
+            return;
+        }
+        const qint64 base = isLocked(item.cfg) ? item.gridNs : item.lastFireNs;
+        item.dueNs = (item.lastFireNs == 0) ? 0 : base + periodNs(item.cfg);
+        item.deadlineNs = (item.lastFireNs == 0) ? 0 : item.dueNs + qint64(item.cfg.slackMs) * 1000000LL;
+        heapPlace(m_dueHeap, slot);
+        heapPlace(m_deadlineHeap, slot);
+    }
+
+    // ---------- 最小堆 ----------
+    bool heapLess(const HeapIndex& h, int a, int b) const {
+        return m_items[h.heap[a]].*h.key < m_items[h.heap[b]].*h.key;
+    }
+    void heapSwap(HeapIndex& h, int a, int b) {
+        qSwap(h.heap[a], h.heap[b]);
+        m_items[h.heap[a]].*h.pos = a;
+        m_items[h.heap[b]].*h.pos = b;
+    }
+    void heapUp(HeapIndex& h, int pos) {
+        while (pos > 0) {
+            const int parent = (pos - 1) / 2;
+            if (!heapLess(h, pos, parent)) break;
+            heapSwap(h, pos, parent);
+            pos = parent;
+        }
+    }
+    void heapDown(HeapIndex& h, int pos) {
+        const int n = h.heap.size();
+        for (;;) {
+            const int l = pos * 2 + 1;
+            const int r = l + 1;
+            int m = pos;
+            if (l < n && heapLess(h, l, m)) m = l;
+            if (r < n && heapLess(h, r, m)) m = r;
+            if (m == pos) break;
+            heapSwap(h, pos, m);
+            pos = m;
+        }
+    }
+    // 不在堆里就插入，在就按新的键值调整位置
+    void heapPlace(HeapIndex& h, int slot) {
+        int& pos = m_items[slot].*h.pos;
+        if (pos < 0) {
+            pos = h.heap.size();
+            h.heap.append(slot);
+            heapUp(h, pos);
+        } else {
+            heapUp(h, pos);
+            heapDown(h, m_items[slot].*h.pos);
+        }
+    }
+    void heapRemove(HeapIndex& h, int slot) {
+        const int pos = m_items[slot].*h.pos;
+        const int last = h.heap.size() - 1;
+        if (pos != last) {
+            heapSwap(h, pos, last);
+        }
+        h.heap.removeLast();
+        m_items[slot].*h.pos = -1;
+        if (pos < h.heap.size()) {
+            heapUp(h, pos);
+            heapDown(h, m_items[h.heap[pos]].*h.pos);
+        }
+    }
+
+    // 自适应唤醒（只在 EventLoop 调度端调用）：把单次定时器定到堆顶的到点时刻（向上取整到 ms，宁晚勿早）
+    // 到点时刻没变且定时器还在走就不重设；提前醒来时 onWakeup 什么都不做，再定一次即可
+    void rearm(qint64 dueNs) {
+        if (!m_running.load() || m_backend.load() != int(Backend::EventLoop)) return;
+        if (!m_schedCfg.adaptiveWakeup) return;
+        if (dueNs < 0) {
+            m_wakeupTimer.stop();
+            return;
+        }
+        if (m_wakeupTimer.isActive() && dueNs == m_armedDueNs) return;
+        m_armedDueNs = dueNs;
+        const qint64 remainNs = dueNs - nowNsec();
+        m_wakeupTimer.start(remainNs > 0 ? int((remainNs + 999999) / 1000000) : 0);
+    }
+
+    // 0 留给“还没有起始相位”
+    qint64 nowNsec() const {
+        return qMax<qint64>(1, m_elapsed.nsecsElapsed());
+    }
+
+    // ---------- 控制端（以下要求已持有 m_ctlMutex） ----------
+    // 镜像里取该 id（不存在则以默认参数创建）
+    MirrorItem& mirrorItem(int id) {
+        auto found = m_mirror.find(id);
+        if (found == m_mirror.end()) {
+            MirrorItem item;
             item.cfg = m_defaultCfg; // 默认参数
-            item.lastFireNs = 0;
-            m_items.insert(id, item);
+            item.cfg.enabled = false;
+            found = m_mirror.insert(id, item);
+            setMirrorEnabled(*found, m_defaultCfg.enabled);
         }
-        return m_items[id];
+        return *found;
+    }
+
+    void setMirrorEnabled(MirrorItem& item, bool enabled) {
+        if (item.cfg.enabled == enabled) return;
+        item.cfg.enabled = enabled;
+        m_mirrorEnabled += enabled ? 1 : -1;
     }
 
-    void ensureWakeupRunning() {
-        if (!m_elapsed.isValid()) {
-            m_elapsed.restart();
-            m_lastWakeNs = m_elapsed.nsecsElapsed();
+    // 在锁里入队：队列顺序和镜像的修改顺序一致
+    void postLocked(Command::Type type, int id, MirrorItem* item) {
+        Command cmd;
+        cmd.type = type;
+        cmd.id = id;
+        cmd.seq = ++m_seq;
+        cmd.atNs = nowNsec();
+        if (item) {
+            item->seq = cmd.seq;
+            cmd.cfg = item->cfg;
         }
-        if (!m_wakeupTimer.isActive()) {
-            m_wakeupTimer.start(m_globalCfg.wakeupMs);
+        if (type == Command::Global) cmd.global = m_globalCfg;
+        m_commands.push(std::move(cmd));
+        kickLocked();
+    }
+
+    // 叫醒调度端来取命令；上一次叫醒还没被处理就不重复叫
+    // 固定轮询模式不用叫，下一次唤醒自然会取
+    void kickLocked() {
+        if (!m_running.load()) return;
+        if (m_kickPending.exchange(true, std::memory_order_acq_rel)) return;
+        if (m_globalCfg.backend == Backend::Thread) {
+            if (m_thread) m_thread->wakeUp();
+        } else if (m_globalCfg.adaptiveWakeup) {
+            runOnOwner([this] {
+                if (m_running.load() && m_backend.load() == int(Backend::EventLoop)) m_wakeupTimer.start(0);
+            });
         }
     }
 
-    bool anyEnabled() const {
-        for (auto it = m_items.constBegin(); it != m_items.constEnd(); ++it) {
-            if (it.value().cfg.enabled) return true;
+    void ensureRunningLocked() {
+        if (m_running.load()) return;
+        m_running.store(true);
+        startWakeupLocked();
+    }
+
+    // 按当前后端/模式（重新）启动唤醒源，并马上叫醒一次把积压的命令取掉
+    // 切到 EventLoop 时调度线程不退出，只是 threadTick 返回 -1 一直睡着，避免在锁里等线程结束
+    void startWakeupLocked() {
+        if (m_globalCfg.backend == Backend::Thread) {
+            if (!m_thread) {
+                m_thread.reset(new TickerThread([this] { return threadTick(); }));
+                m_thread->setObjectName(QStringLiteral("MultiMsTicker"));
+            }
+            m_thread->setRealtimePriority(m_globalCfg.threadPriority);
+            if (!m_thread->isRunning()) m_thread->start();
+            m_thread->wakeUp();
         }
-        return false;
+        syncWakeupTimerLocked();
+    }
+
+    // 返回 true 表示确实从运行变为停止（调用方解锁后再发 stopped）
+    // Thread 后端：调度线程不退出，tick 返回 -1 后一直睡着
+    bool stopLocked() {
+        if (!m_running.load()) return false;
+        m_running.store(false);
+        syncWakeupTimerLocked();
+        return true;
+    }
+
+    // QTimer 只能在所属线程上动：按调用时刻的状态生成操作，投递到所属线程按顺序执行
+    void syncWakeupTimerLocked() {
+        const bool loop = m_running.load() && m_globalCfg.backend == Backend::EventLoop;
+        const bool adaptive = m_globalCfg.adaptiveWakeup;
+        const int wakeupMs = m_globalCfg.wakeupMs;
+        runOnOwner([this, loop, adaptive, wakeupMs] {
+            if (!loop) {
+                m_wakeupTimer.stop();
+                return;
+            }
+            m_wakeupTimer.setSingleShot(adaptive);
+            // 自适应：先马上醒一次，由调度端按堆顶重新定
+            m_wakeupTimer.start(adaptive ? 0 : wakeupMs);
+        });
+    }
+
+    template <class Fn>
+    void runOnOwner(Fn fn) {
+        if (QThread::currentThread() == thread()) {
+            fn();
+            return;
+        }
+        QMetaObject::invokeMethod(this, std::move(fn), Qt::QueuedConnection);
     }
 
 private:
-    // 全局
+    static constexpr qint64 kMinIntervalNs = 1000; // ns 周期下限，防止 Burst 补发失控
+
+    // ---------- 控制端 ----------
+    mutable QMutex m_ctlMutex; // 保护镜像和配置；只在控制接口和冷路径（单发结束、首次统计、自动停止）上拿
     GlobalConfig m_globalCfg;
     TimerConfig  m_defaultCfg;
+    QHash<int, MirrorItem> m_mirror;
+    int     m_mirrorEnabled = 0;
+    quint64 m_seq = 0;
+    TimeoutCallback m_callback; // startAll 之前设置，之后调度端只读
+    std::unique_ptr<TickerThread> m_thread;
+
+    // ---------- 两端共享 ----------
+    QElapsedTimer m_elapsed;   // 构造时启动，之后只读
+    QTimer m_wakeupTimer;      // 只在所属线程上操作
+    std::atomic<bool> m_running{false};
+    std::atomic<int>  m_backend{int(Backend::EventLoop)};
+    std::atomic<bool> m_kickPending{false}; // 已叫醒调度端、它还没来取
+    std::atomic<bool> m_inScheduler{false};
+    MpscQueue<Command> m_commands;
+    TickerStats m_wakeStats;   // 唤醒扫描耗时
+    TickerStats m_allStats;    // 所有 timer 合计的触发延迟
+    std::atomic<QThreadPool*> m_pool{nullptr};
+    std::atomic<int>     m_poolTasks{0};     // 线程池里还没结束的任务
+    std::atomic<quint64> m_dispatched{0};
+    std::atomic<quint64> m_overlapped{0};
+    std::atomic<quint64> m_skipped{0};
+    std::atomic<quint64> m_firingWakeups{0};
+    std::atomic<quint64> m_savedWakeups{0};
 
-    QTimer m_wakeupTimer;
-    QElapsedTimer m_elapsed;
+    // ---------- 调度端（只在 processDue 里访问） ----------
+    GlobalConfig m_schedCfg;
     qint64 m_lastWakeNs = 0;
+    qint64 m_armedDueNs = -1;  // 自适应模式当前定到的到点时刻
+    QVector<TimeoutRecord> m_batch; // timeoutBatch 的复用缓冲
 
-    // id -> timer
-    QHash<int, TimerItem> m_items;
+    // timer 存在稠密数组里；id -> 下标；到点时间、截止时间各用一个最小堆索引
+    QVector<TimerItem> m_items;
+    QHash<int, int>    m_index;
+    HeapIndex m_dueHeap{ {}, &TimerItem::dueNs, &TimerItem::heapPos };
+    HeapIndex m_deadlineHeap{ {}, &TimerItem::deadlineNs, &TimerItem::deadlinePos };
+    QHash<int, qint64> m_groupOrigin; // 对齐组 -> 组起点
+    int m_enabledCount = 0;
 };
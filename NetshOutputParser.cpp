@@ -0,0 +1,242 @@
+#include "NetshOutputParser.h"
+#include <QVector>
+
+namespace {
+
+enum class Field {
+    None,
+    // netsh wlan show interfaces
+    Name, Description, State, Ssid, Bssid, Mac, Signal, RxRate, TxRate, PhyRate,
+    // netsh interface ip show config / ipconfig
+    IpAddress, Ipv4, Gateway,
+    // netsh wlan show profiles
+    Profile,
+};
+
+struct Label
+{
+    QString text;
+    Field   field;
+};
+
+// 标签表：一种语言一张，按原来 if 链的顺序排（先匹配先赢，接收/传输速率要排在“速率”前面）
+// 中文按 UTF-8 源码解释（同 NetshWlanReaderV.cpp 里的字面量），只在第一次用时建一次
+struct LabelTables
+{
+    QVector<Label> wlanZh, wlanEn;   // 行首匹配
+    QVector<Label> ipZh, ipEn;       // 行内包含
+    QVector<Label> profileZh, profileEn;
+    QString none;                    // 网关的“无”
+
+    LabelTables()
+    {
+        wlanZh = {
+            {QString::fromUtf8("名称"), Field::Name},
+            {QString::fromUtf8("说明"), Field::Description},
+            {QString::fromUtf8("状态"), Field::State},
+            {QString::fromUtf8("物理地址"), Field::Mac},
+            {QString::fromUtf8("信号"), Field::Signal},
+            {QString::fromUtf8("接收速率"), Field::RxRate},
+            {QString::fromUtf8("传输速率"), Field::TxRate},
+            {QString::fromUtf8("速率"), Field::PhyRate},
+        };
+        wlanEn = {
+            {QStringLiteral("Name"), Field::Name},
+            {QStringLiteral("Description"), Field::Description},
+            {QStringLiteral("State"), Field::State},
+            {QStringLiteral("SSID"), Field::Ssid},
+            {QStringLiteral("BSSID"), Field::Bssid},
+            {QStringLiteral("Physical address"), Field::Mac},
+            {QStringLiteral("Signal"), Field::Signal},
+            {QStringLiteral("Receive rate"), Field::RxRate},
+            {QStringLiteral("Transmit rate"), Field::TxRate},
+            {QStringLiteral("Rate"), Field::PhyRate},
+        };
+        ipZh = {
+            {QString::fromUtf8("IP 地址"), Field::IpAddress},
+            {QString::fromUtf8("默认网关"), Field::Gateway},
+        };
+        ipEn = {
+            {QStringLiteral("IP Address"), Field::IpAddress},
+            {QStringLiteral("IPv4"), Field::Ipv4},
+            {QStringLiteral("Default Gateway"), Field::Gateway},
+        };
+        profileZh = { {QString::fromUtf8("所有用户配置文件"), Field::Profile} };
+        profileEn = { {QStringLiteral("All User Profile"), Field::Profile} };
+        none = QString::fromUtf8("无");
+    }
+};
+
+const LabelTables &tables()
+{
+    static const LabelTables t;
+    return t;
+}
+
+// 中文标签都以汉字开头，英文（包括中文系统里的 SSID/BSSID）以 ASCII 开头：按行首字符选表
+bool isAsciiLead(QStringView line)
+{
+    return !line.isEmpty() && line[0].unicode() < 0x80;
+}
+
+Field matchPrefix(QStringView line, const QVector<Label> &table)
+{
+    const QChar lead = line[0];
+    for (const Label &l : table) {
+        if (l.text[0] == lead && line.startsWith(l.text)) return l.field;
+    }
+    return Field::None;
+}
+
+// 行内任意位置包含标签（ipconfig 的 "IPv4 地址 . . ." 和 netsh 的 "IP 地址:" 都不一定在行首）
+Field matchContains(QStringView line, const QVector<Label> &zh, const QVector<Label> &en)
+{
+    for (const Label &l : zh) {
+        if (line.indexOf(l.text) >= 0) return l.field;
+    }
+    for (const Label &l : en) {
+        if (line.indexOf(l.text) >= 0) return l.field;
+    }
+    return Field::None;
+}
+
+bool isAdapterHeader(QStringView line)
+{
+    static const QString zh = QString::fromUtf8("适配器");
+    return line.indexOf(zh) >= 0 || line.indexOf(QLatin1String("adapter"), 0, Qt::CaseInsensitive) >= 0;
+}
+
+} // namespace
+
+QStringView NetshOutputParser::valueAfterColon(QStringView line)
+{
+    qsizetype idx = line.indexOf(QLatin1Char(':'));
+    if (idx < 0) idx = line.indexOf(QChar(0xFF1A)); // 全角：
+    if (idx < 0) return QStringView();
+    return line.mid(idx + 1).trimmed();
+}
+
+int NetshOutputParser::parseFirstInt(QStringView s)
+{
+    int value = 0;
+    bool found = false;
+    for (QChar c : s) {
+        if (c.isDigit()) {
+            found = true;
+            if (value < 100000000) value = value * 10 + c.digitValue();
+        } else if (found) {
+            break;
+        }
+    }
+    return found ? value : -1;
+}
+
+bool NetshOutputParser::textIsConnected(QStringView stateText)
+{
+    static const QString zh = QString::fromUtf8("已连接");
+    if (stateText.indexOf(zh) >= 0) return true;
+    if (stateText.indexOf(QLatin1String("connected"), 0, Qt::CaseInsensitive) >= 0) return true;
+    return false;
+}
+
+void NetshOutputParser::parseWlanInterfaces(QStringView output, WifiInfo &info)
+{
+    // 防止残留
+    info.signalPct   = -1;
+    info.phyRateMbps = -1;
+    info.rxRateMbps  = -1;
+    info.txRateMbps  = -1;
+
+    const LabelTables &t = tables();
+    forEachLine(output, [&](QStringView line) {
+        const Field f = matchPrefix(line, isAsciiLead(line) ? t.wlanEn : t.wlanZh);
+        switch (f) {
+        case Field::Name:        info.interfaceName = valueAfterColon(line).toString(); break;
+        case Field::Description: info.interfaceDesc = valueAfterColon(line).toString(); break;
+        case Field::State:
+            info.state = valueAfterColon(line).toString();
+            info.connected = textIsConnected(info.state);
+            break;
+        case Field::Ssid:        info.ssid = valueAfterColon(line).toString(); break;
+        case Field::Bssid:       info.bssid = valueAfterColon(line).toString(); break;
+        case Field::Mac:         info.mac = valueAfterColon(line).toString(); break;
+        case Field::Signal:      info.signalPct = parseFirstInt(valueAfterColon(line)); break;
+        // 多个 BSSID / 多行速率时只取第一个
+        case Field::RxRate:
+            if (info.rxRateMbps < 0) info.rxRateMbps = parseFirstInt(valueAfterColon(line));
+            break;
+        case Field::TxRate:
+            if (info.txRateMbps < 0) info.txRateMbps = parseFirstInt(valueAfterColon(line));
+            break;
+        case Field::PhyRate:     // PHY/协商速率（很多机器没有这行，留空很正常）
+            if (info.phyRateMbps < 0) info.phyRateMbps = parseFirstInt(valueAfterColon(line));
+            break;
+        default:
+            break;
+        }
+        return true;
+    });
+
+    // 兜底：有 SSID 就认为连接（有些系统 state 不稳定）
+    if (!info.connected && !info.ssid.isEmpty() && info.ssid != QLatin1String("-")) {
+        info.connected = true;
+        if (info.state.isEmpty()) info.state = QString::fromUtf8("已连接");
+    }
+}
+
+QStringList NetshOutputParser::parseProfiles(QStringView output)
+{
+    const LabelTables &t = tables();
+    QStringList list;
+    forEachLine(output, [&](QStringView line) {
+        if (matchContains(line, t.profileZh, t.profileEn) == Field::Profile) {
+            const QStringView name = valueAfterColon(line);
+            if (!name.isEmpty()) list << name.toString();
+        }
+        return true;
+    });
+    list.removeDuplicates();
+    return list;
+}
+
+bool NetshOutputParser::parseNetshIpConfig(QStringView output, WifiInfo &io)
+{
+    const LabelTables &t = tables();
+    forEachLine(output, [&](QStringView line) {
+        const Field f = matchContains(line, t.ipZh, t.ipEn);
+        if (f == Field::IpAddress) {
+            const QStringView v = valueAfterColon(line);
+            if (!v.isEmpty()) io.ipv4 = v.toString();
+        } else if (f == Field::Gateway) {
+            const QStringView v = valueAfterColon(line);
+            if (!v.isEmpty() && v != QStringView(t.none)) io.gateway = v.toString();
+        }
+        return true;
+    });
+    return !io.ipv4.isEmpty() || !io.gateway.isEmpty();
+}
+
+bool NetshOutputParser::parseIpconfig(QStringView output, QStringView iface, WifiInfo &io)
+{
+    // 段落：从包含 iface 的那行（适配器标题）到下一个适配器标题；
+    // 标题和字段之间本来就隔着空行，所以空行不算段落结束
+    const LabelTables &t = tables();
+    bool inSection = false;
+    forEachLine(output, [&](QStringView line) {
+        if (!inSection) {
+            inSection = line.indexOf(iface, 0, Qt::CaseInsensitive) >= 0;
+            return true;
+        }
+        if (isAdapterHeader(line)) return false;
+
+        const Field f = matchContains(line, t.ipZh, t.ipEn);
+        if (f == Field::Ipv4) {
+            io.ipv4 = valueAfterColon(line).toString();
+        } else if (f == Field::Gateway) {
+            const QStringView v = valueAfterColon(line);
+            if (!v.isEmpty() && v != QStringView(t.none)) io.gateway = v.toString();
+        }
+        return true;
+    });
+    return !io.ipv4.isEmpty() || !io.gateway.isEmpty();
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include "NetshWlanReaderV.h"
+
+// netsh / ipconfig 输出解析：一遍扫描，按行切 QStringView、不拷贝不 trim 成新串，
+// 键名查预先建好的中英文标签表（每种语言一张），只有最终写进 WifiInfo 的字段值才分配
+class NetshOutputParser
+{
+public:
+    // netsh wlan show interfaces
+    static void parseWlanInterfaces(QStringView output, WifiInfo &info);
+
+    // netsh wlan show profiles
+    static QStringList parseProfiles(QStringView output);
+
+    // netsh interface ipv4/ip show config name="..."
+    static bool parseNetshIpConfig(QStringView output, WifiInfo &io);
+
+    // ipconfig：只看 iface 所在的适配器段落
+    static bool parseIpconfig(QStringView output, QStringView iface, WifiInfo &io);
+
+    // ---------- 工具 ----------
+    // 第一个 ':'（没有时找全角 '：'）之后的部分，去掉首尾空白
+    static QStringView valueAfterColon(QStringView line);
+    // 第一段连续数字，没有返回 -1
+    static int parseFirstInt(QStringView s);
+    static bool textIsConnected(QStringView stateText);
+
+    // 逐行回调（已去掉首尾空白，跳过空行）；fn 返回 false 时停止
+    template <class Fn>
+    static void forEachLine(QStringView text, Fn fn)
+    {
+        int pos = 0;
+        const int n = int(text.size());
+        while (pos <= n) {
+            int end = pos;
+            while (end < n && text[end] != QLatin1Char('\n')) ++end;
+            const QStringView line = text.mid(pos, end - pos).trimmed();
+            if (!line.isEmpty() && !fn(line)) return;
+            pos = end + 1;
+        }
+    }
+};
@@ -0,0 +1,336 @@
+// NetshOutputParser 基准（无界面，QCoreApplication）
+//
+// 对一组录下来的 netsh / ipconfig 输出反复解析，每条语料输出一行 JSON：
+//   每次解析耗时、吞吐、解析出的关键字段（顺便核对结果没变）
+// interfaces 语料额外跑一遍改写前的 split + trim + startsWith 写法作对照
+//
+// 用法：NetshParseBench [--iterations N] [--corpus DIR]
+//   DIR 下的 *.txt 按文件名前缀归类：interfaces* / netship* / ipconfig* / profiles*
+//   （本地编码，即 netsh 原样重定向出来的文件）；ipconfig 语料用 --iface 指定接口名，默认 WLAN
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QVector>
+#include "BenchUtil.h"
+#include "NetshOutputParser.h"
+
+namespace {
+
+enum class Kind { Interfaces, NetshIp, Ipconfig, Profiles };
+
+struct Sample {
+    QString name;
+    Kind    kind;
+    QString text;
+};
+
+struct BenchOptions {
+    int iterations = 20000;
+    QString corpusDir;
+    QString iface = QStringLiteral("WLAN");
+};
+
+// ---------- 内置语料（Win10/11 中英文系统上录的，MAC/IP 已改） ----------
+const char* const kInterfacesZh =
+    "\r\n系统上有 1 个接口:\r\n\r\n"
+    "    名称                   : WLAN\r\n"
+    "    说明                   : Intel(R) Wi-Fi 6 AX203\r\n"
+    "    GUID                   : 3b6a2f0e-7c1d-4a5e-9f40-1d2c3b4a5e6f\r\n"
+    "    物理地址               : 90:09:df:51:20:b1\r\n"
+    "    界面类型               : 主要\r\n"
+    "    状态                   : 已连接\r\n"
+    "    SSID                   : AMNet_VPN_5G\r\n"
+    "    BSSID                  : c4:70:ab:20:81:df\r\n"
+    "    网络类型               : 结构\r\n"
+    "    无线电类型             : 802.11ax\r\n"
+    "    身份验证               : WPA2 - 个人\r\n"
+    "    密码                   : CCMP\r\n"
+    "    连接模式               : 配置文件\r\n"
+    "    频带                   : 5 GHz\r\n"
+    "    通道                   : 149\r\n"
+    "    接收速率(Mbps)         : 1201\r\n"
+    "    传输速率 (Mbps)        : 1201\r\n"
+    "    信号                   : 92%\r\n"
+    "    配置文件               : AMNet_VPN_5G\r\n"
+    "    QoS MSCS 已配置         : 0\r\n"
+    "    QoS 映射已配置          : 0\r\n"
+    "    QoS 映射已被策略允许   : 0\r\n\r\n"
+    "    承载网络状态  : 不可用\r\n";
+
+const char* const kInterfacesEn =
+    "\r\nThere is 1 interface on the system:\r\n\r\n"
+    "    Name                   : Wi-Fi\r\n"
+    "    Description            : Intel(R) Wi-Fi 6 AX201 160MHz\r\n"
+    "    GUID                   : 9a8b7c6d-5e4f-4a3b-2c1d-0e9f8a7b6c5d\r\n"
+    "    Physical address       : 3c:58:c2:11:22:33\r\n"
+    "    Interface type         : Primary\r\n"
+    "    State                  : connected\r\n"
+    "    SSID                   : Office-5G\r\n"
+    "    BSSID                  : 70:3a:0e:44:55:66\r\n"
+    "    Network type           : Infrastructure\r\n"
+    "    Radio type             : 802.11ac\r\n"
+    "    Authentication         : WPA2-Personal\r\n"
+    "    Cipher                 : CCMP\r\n"
+    "    Connection mode        : Auto Connect\r\n"
+    "    Band                   : 5 GHz\r\n"
+    "    Channel                : 36\r\n"
+    "    Receive rate (Mbps)    : 866.7\r\n"
+    "    Transmit rate (Mbps)   : 585\r\n"
+    "    Signal                 : 88%\r\n"
+    "    Profile                : Office-5G\r\n\r\n"
+    "    Hosted network status  : Not available\r\n";
+
+const char* const kNetshIpZh =
+    "\r\n接口 \"WLAN\" 的配置\r\n"
+    "    DHCP 已启用:                          是\r\n"
+    "    IP 地址:                           192.168.100.212\r\n"
+    "    子网前缀:                        192.168.100.0/24 (掩码 255.255.255.0)\r\n"
+    "    默认网关:                         192.168.100.1\r\n"
+    "    网关跃点数:                       0\r\n"
+    "    InterfaceMetric:                      35\r\n"
+    "    通过 DHCP 配置的 DNS 服务器:  192.168.100.1\r\n"
+    "    用哪个前缀注册:                   只是主要\r\n"
+    "    通过 DHCP 配置的 WINS 服务器:  无\r\n";
+
+const char* const kNetshIpEn =
+    "\r\nConfiguration for interface \"Wi-Fi\"\r\n"
+    "    DHCP enabled:                         Yes\r\n"
+    "    IP Address:                           192.168.1.23\r\n"
+    "    Subnet Prefix:                        192.168.1.0/24 (mask 255.255.255.0)\r\n"
+    "    Default Gateway:                      192.168.1.1\r\n"
+    "    Gateway Metric:                       0\r\n"
+    "    InterfaceMetric:                      35\r\n"
+    "    DNS servers configured through DHCP:  192.168.1.1\r\n"
+    "    Register with which suffix:           Primary only\r\n"
+    "    WINS servers configured through DHCP: None\r\n";
+
+const char* const kIpconfigZh =
+    "\r\nWindows IP 配置\r\n\r\n\r\n"
+    "以太网适配器 以太网:\r\n\r\n"
+    "   媒体状态  . . . . . . . . . . . . : 媒体已断开连接\r\n"
+    "   连接特定的 DNS 后缀 . . . . . . . : \r\n\r\n"
+    "无线局域网适配器 本地连接* 1:\r\n\r\n"
+    "   媒体状态  . . . . . . . . . . . . : 媒体已断开连接\r\n"
+    "   连接特定的 DNS 后缀 . . . . . . . : \r\n\r\n"
+    "无线局域网适配器 WLAN:\r\n\r\n"
+    "   连接特定的 DNS 后缀 . . . . . . . : \r\n"
+    "   本地链接 IPv6 地址. . . . . . . . : fe80::1c2f:3a4b:5c6d:7e8f%12\r\n"
+    "   IPv4 地址 . . . . . . . . . . . . : 192.168.100.212\r\n"
+    "   子网掩码  . . . . . . . . . . . . : 255.255.255.0\r\n"
+    "   默认网关. . . . . . . . . . . . . : 192.168.100.1\r\n\r\n"
+    "以太网适配器 蓝牙网络连接:\r\n\r\n"
+    "   媒体状态  . . . . . . . . . . . . : 媒体已断开连接\r\n";
+
+const char* const kIpconfigEn =
+    "\r\nWindows IP Configuration\r\n\r\n\r\n"
+    "Ethernet adapter Ethernet:\r\n\r\n"
+    "   Media State . . . . . . . . . . . : Media disconnected\r\n"
+    "   Connection-specific DNS Suffix  . : \r\n\r\n"
+    "Wireless LAN adapter WLAN:\r\n\r\n"
+    "   Connection-specific DNS Suffix  . : lan\r\n"
+    "   Link-local IPv6 Address . . . . . : fe80::9d2e:1f3a:4b5c:6d7e%7\r\n"
+    "   IPv4 Address. . . . . . . . . . . : 192.168.1.23\r\n"
+    "   Subnet Mask . . . . . . . . . . . : 255.255.255.0\r\n"
+    "   Default Gateway . . . . . . . . . : 192.168.1.1\r\n";
+
+const char* const kProfilesZh =
+    "\r\n接口 WLAN 上的配置文件:\r\n\r\n\r\n"
+    "组策略配置文件(只读)\r\n"
+    "---------------------------------\r\n"
+    "    <无>\r\n\r\n"
+    "用户配置文件\r\n"
+    "-------------\r\n"
+    "    所有用户配置文件 : AMNet_VPN_5G\r\n"
+    "    所有用户配置文件 : AMNet\r\n"
+    "    所有用户配置文件 : Guest-2.4G\r\n"
+    "    所有用户配置文件 : 会议室\r\n\r\n";
+
+const char* const kProfilesEn =
+    "\r\nProfiles on interface Wi-Fi:\r\n\r\n"
+    "Group policy profiles (read only)\r\n"
+    "---------------------------------\r\n"
+    "    <None>\r\n\r\n"
+    "User profiles\r\n"
+    "-------------\r\n"
+    "    All User Profile     : Office-5G\r\n"
+    "    All User Profile     : Office\r\n"
+    "    All User Profile     : Home\r\n";
+
+QVector<Sample> builtinCorpus() {
+    return {
+        { QStringLiteral("interfaces-zh"), Kind::Interfaces, QString::fromUtf8(kInterfacesZh) },
+        { QStringLiteral("interfaces-en"), Kind::Interfaces, QString::fromUtf8(kInterfacesEn) },
+        { QStringLiteral("netship-zh"),    Kind::NetshIp,    QString::fromUtf8(kNetshIpZh) },
+        { QStringLiteral("netship-en"),    Kind::NetshIp,    QString::fromUtf8(kNetshIpEn) },
+        { QStringLiteral("ipconfig-zh"),   Kind::Ipconfig,   QString::fromUtf8(kIpconfigZh) },
+        { QStringLiteral("ipconfig-en"),   Kind::Ipconfig,   QString::fromUtf8(kIpconfigEn) },
+        { QStringLiteral("profiles-zh"),   Kind::Profiles,   QString::fromUtf8(kProfilesZh) },
+        { QStringLiteral("profiles-en"),   Kind::Profiles,   QString::fromUtf8(kProfilesEn) },
+    };
+}
+
+QVector<Sample> loadCorpus(const QString& dirPath) {
+    QVector<Sample> out;
+    const QDir dir(dirPath);
+    const QStringList files = dir.entryList(QStringList() << QStringLiteral("*.txt"), QDir::Files, QDir::Name);
+    for (const QString& name : files) {
+        Kind kind;
+        if (name.startsWith(QStringLiteral("interfaces"))) kind = Kind::Interfaces;
+        else if (name.startsWith(QStringLiteral("netship"))) kind = Kind::NetshIp;
+        else if (name.startsWith(QStringLiteral("ipconfig"))) kind = Kind::Ipconfig;
+        else if (name.startsWith(QStringLiteral("profiles"))) kind = Kind::Profiles;
+        else continue;
+        QFile f(dir.filePath(name));
+        if (!f.open(QIODevice::ReadOnly)) continue;
+        out.push_back({ name, kind, QString::fromLocal8Bit(f.readAll()) });
+    }
+    return out;
+}
+
+// 改写前 NetshWlanReader::parseWlanInterfaces 的写法（整段 split、每行 trimmed 拷贝、逐个 startsWith）
+QString legacyValueAfterColon(const QString& line) {
+    int idx = line.indexOf(':');
+    if (idx < 0) idx = line.indexOf(QChar(0xFF1A));
+    if (idx < 0) return QString();
+    return line.mid(idx + 1).trimmed();
+}
+
+int legacyParseFirstInt(const QString& s) {
+    QString t = s.trimmed();
+    QString num;
+    for (QChar c : t) {
+        if (c.isDigit()) num.append(c);
+        else if (!num.isEmpty()) break;
+    }
+    return num.isEmpty() ? -1 : num.toInt();
+}
+
+void legacyParseWlanInterfaces(const QString& output, WifiInfo& info) {
+    info.signalPct = info.phyRateMbps = info.rxRateMbps = info.txRateMbps = -1;
+    const QStringList lines = output.split('\n');
+    for (QString line : lines) {
+        line = line.trimmed();
+        if (line.isEmpty()) continue;
+        if (line.startsWith("名称") || line.startsWith("Name")) { info.interfaceName = legacyValueAfterColon(line); continue; }
+        if (line.startsWith("说明") || line.startsWith("Description")) { info.interfaceDesc = legacyValueAfterColon(line); continue; }
+        if (line.startsWith("状态") || line.startsWith("State")) {
+            info.state = legacyValueAfterColon(line);
+            info.connected = info.state.contains("已连接") || info.state.contains("connected", Qt::CaseInsensitive);
+            continue;
+        }
+        if (line.startsWith("SSID") && !line.startsWith("BSSID")) { info.ssid = legacyValueAfterColon(line); continue; }
+        if (line.startsWith("BSSID")) { info.bssid = legacyValueAfterColon(line); continue; }
+        if (line.startsWith("物理地址") || line.startsWith("Physical address")) { info.mac = legacyValueAfterColon(line); continue; }
+        if (line.startsWith("信号") || line.startsWith("Signal")) { info.signalPct = legacyParseFirstInt(legacyValueAfterColon(line)); continue; }
+        if (line.startsWith("接收速率") || line.startsWith("Receive rate")) {
+            if (info.rxRateMbps < 0) info.rxRateMbps = legacyParseFirstInt(legacyValueAfterColon(line));
+            continue;
+        }
+        if (line.startsWith("传输速率") || line.startsWith("Transmit rate")) {
+            if (info.txRateMbps < 0) info.txRateMbps = legacyParseFirstInt(legacyValueAfterColon(line));
+            continue;
+        }
+        if (line.startsWith("速率") || line.startsWith("Rate")) {
+            if (info.phyRateMbps < 0) info.phyRateMbps = legacyParseFirstInt(legacyValueAfterColon(line));
+            continue;
+        }
+    }
+}
+
+// 解析一次，结果留在 w / profiles 里
+void parseOnce(const Sample& s, const QString& iface, bool legacy, WifiInfo& w, QStringList& profiles) {
+    switch (s.kind) {
+    case Kind::Interfaces:
+        if (legacy) legacyParseWlanInterfaces(s.text, w);
+        else NetshOutputParser::parseWlanInterfaces(s.text, w);
+        break;
+    case Kind::NetshIp:
+        NetshOutputParser::parseNetshIpConfig(s.text, w);
+        break;
+    case Kind::Ipconfig:
+        NetshOutputParser::parseIpconfig(s.text, iface, w);
+        break;
+    case Kind::Profiles:
+        profiles = NetshOutputParser::parseProfiles(s.text);
+        break;
+    }
+}
+
+// 计时循环里的防优化值：只加几个长度/整数，不拼字符串（拼串的开销会算进解析耗时）
+int sinkOf(const WifiInfo& w, const QStringList& profiles) {
+    return int(w.interfaceName.size() + w.ssid.size() + w.bssid.size() + w.ipv4.size() + w.gateway.size())
+        + w.signalPct + w.rxRateMbps + int(profiles.size());
+}
+
+// 结果摘要（写进 JSON 核对字段），只在计时之外算一次
+QString summaryOf(Kind kind, const WifiInfo& w, const QStringList& profiles) {
+    switch (kind) {
+    case Kind::Interfaces:
+        return QStringList({ w.interfaceName, w.ssid, w.bssid, w.state,
+                             QString::number(w.signalPct) + QStringLiteral("/") + QString::number(w.rxRateMbps) })
+            .join(QStringLiteral("|"));
+    case Kind::NetshIp:
+    case Kind::Ipconfig:
+        return w.ipv4 + QStringLiteral("|") + w.gateway;
+    case Kind::Profiles:
+        return profiles.join(QStringLiteral(","));
+    }
+    return QString();
+}
+
+void runSample(const BenchOptions& opt, const Sample& s, bool legacy) {
+    WifiInfo first;
+    QStringList firstProfiles;
+    parseOnce(s, opt.iface, legacy, first, firstProfiles); // 预热，结果拿来做摘要
+
+    QElapsedTimer t;
+    t.start();
+    qint64 sink = 0;
+    for (int i = 0; i < opt.iterations; ++i) {
+        WifiInfo w;
+        QStringList profiles;
+        parseOnce(s, opt.iface, legacy, w, profiles);
+        sink += sinkOf(w, profiles);
+    }
+    const qint64 ns = t.nsecsElapsed();
+
+    const double nsPerParse = double(ns) / opt.iterations;
+    const double mbPerSec = nsPerParse > 0 ? (s.text.size() * 2.0) / nsPerParse * 1e3 : 0.0; // UTF-16 字节
+    BenchJson()
+        .field("corpus", s.name)
+        .field("parser", legacy ? "legacy" : "view")
+        .field("chars", int(s.text.size()))
+        .field("iterations", opt.iterations)
+        .field("nsPerParse", nsPerParse)
+        .field("mbPerSec", mbPerSec)
+        .field("result", summaryOf(s.kind, first, firstProfiles))
+        .field("sink", sink)
+        .print();
+}
+
+BenchOptions parseOptions(const QStringList& argv) {
+    const BenchArgs args(argv);
+    BenchOptions opt;
+    opt.iterations = args.intValue("--iterations", opt.iterations, 1);
+    opt.corpusDir = args.value("--corpus");
+    opt.iface = args.value("--iface", opt.iface);
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const BenchOptions opt = parseOptions(app.arguments());
+
+    QVector<Sample> corpus = builtinCorpus();
+    if (!opt.corpusDir.isEmpty()) corpus += loadCorpus(opt.corpusDir);
+
+    for (const Sample& s : corpus) {
+        runSample(opt, s, false);
+        if (s.kind == Kind::Interfaces) runSample(opt, s, true);
+    }
+    return 0;
+}
@@ -0,0 +1,560 @@
+#include "NetshWlanAsync.h"
+#include "NetshOutputParser.h"
+#include "WlanBackend.h"
+#include <QElapsedTimer>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QProcess>
+#include <QSocketNotifier>
+#include <QTimer>
+#include <memory>
+
+// ---------- 操作基类：截止时间 + 正在跑的子进程 ----------
+class NetshWlanAsync::OpBase : public QObject
+{
+public:
+    OpBase(NetshWlanAsync *owner, int deadlineMs)
+        : QObject(owner)
+        , m_owner(owner)
+    {
+        m_clock.start();
+        m_deadline.setSingleShot(true);
+        connect(&m_deadline, &QTimer::timeout, this, [this]() { expire(); });
+        if (deadlineMs > 0) m_deadline.start(deadlineMs);
+    }
+
+    ~OpBase() override { stopProcesses(); }
+
+    // 起一条命令（默认 cmd /c），可以同时起多条；单条超时或启动失败时 out 为空（同 NetshWlanReader::runCmd）
+    void run(const QString &cmd, int timeoutMs, const OutputFn &next)
+    {
+        if (m_done) return;
+
+        QProcess *p = new QProcess(this);
+        QTimer *timer = new QTimer(this);
+        timer->setSingleShot(true);
+        m_procs.insert(p, timer);
+
+        auto finish = [this, p, next](bool noOutput) {
+            if (!m_procs.contains(p)) return; // 已经被杀掉
+            const QString out = noOutput ? QString() : QString::fromLocal8Bit(p->readAllStandardOutput());
+            dispose(p);
+            if (!m_done) next(out);
+        };
+        connect(p, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this,
+                [finish](int, QProcess::ExitStatus) { finish(false); });
+        connect(p, &QProcess::errorOccurred, this, [finish](QProcess::ProcessError e) {
+            if (e == QProcess::FailedToStart) finish(true);
+        });
+        connect(timer, &QTimer::timeout, this, [finish]() { finish(true); });
+        timer->start(timeoutMs);
+        QStringList args = m_owner->m_shellArguments;
+        args << cmd;
+        p->start(m_owner->m_shellProgram, args);
+    }
+
+    // ms 之后继续（代替同步版的 msleep）；ms = 0 即推迟到调用返回之后
+    void after(int ms, const std::function<void()> &next)
+    {
+        QTimer::singleShot(ms, this, [this, next]() {
+            if (!m_done) next();
+        });
+    }
+
+    // 杀掉所有还在跑的命令（它们的回调不会再被调用）
+    void stopProcesses()
+    {
+        const QList<QProcess *> procs = m_procs.keys();
+        for (QProcess *p : procs)
+            dispose(p);
+    }
+
+    bool isDone() const { return m_done; }
+    virtual void cancel() = 0;
+
+protected:
+    virtual void expire() = 0;
+
+    // 只有第一次返回 true：停计时器、杀子进程、从 owner 摘掉，之后的回调都不再执行
+    bool markDone()
+    {
+        if (m_done) return false;
+        m_done = true;
+        m_deadline.stop();
+        stopProcesses();
+        m_owner->m_ops.remove(this);
+        deleteLater();
+        return true;
+    }
+
+    NetshWlanAsync *m_owner;
+    QElapsedTimer m_clock; // 从发起调用算起
+
+private:
+    // 摘掉一条命令；还在跑的杀掉，等它自己退出后再删（不 waitForFinished）
+    void dispose(QProcess *p)
+    {
+        QTimer *timer = m_procs.take(p);
+        if (timer) {
+            timer->stop();
+            timer->deleteLater();
+        }
+        p->disconnect(this);
+        p->setParent(m_owner);
+        if (p->state() == QProcess::NotRunning) {
+            p->deleteLater();
+            return;
+        }
+        connect(p, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), p, &QObject::deleteLater);
+        p->kill();
+    }
+
+    QTimer m_deadline;
+    QHash<QProcess *, QTimer *> m_procs; // 正在跑的命令 -> 它的单条超时
+    bool m_done = false;
+};
+
+// ---------- 带结果类型的操作：future + 完成信号 ----------
+template <class T>
+class NetshWlanAsync::Op : public OpBase
+{
+public:
+    using Signal = void (NetshWlanAsync::*)(const NetshReply<T> &);
+
+    Op(NetshWlanAsync *owner, int deadlineMs, Signal signal)
+        : OpBase(owner, deadlineMs)
+        , m_signal(signal)
+    {
+        m_fi.reportStarted();
+        // 调用方 future.cancel()
+        m_watcher.setFuture(m_fi.future());
+        connect(&m_watcher, &QFutureWatcherBase::canceled, this, [this]() { cancel(); });
+    }
+
+    QFuture<NetshReply<T>> future() { return m_fi.future(); }
+
+    void succeed()
+    {
+        reply.ok = true;
+        reply.errorText.clear();
+        deliver();
+    }
+
+    void fail(const QString &errorText)
+    {
+        reply.ok = false;
+        reply.errorText = errorText;
+        deliver();
+    }
+
+    void cancel() override
+    {
+        if (!markDone()) return;
+        m_fi.reportCanceled();
+        m_fi.reportFinished();
+    }
+
+    NetshReply<T> reply;
+
+protected:
+    void expire() override
+    {
+        reply.timedOut = true;
+        fail("操作超时");
+    }
+
+private:
+    void deliver()
+    {
+        // 调用方已经 future.cancel()、watcher 的通知还没到：按取消处理，不交付结果
+        if (m_fi.isCanceled()) {
+            cancel();
+            return;
+        }
+        if (!markDone()) return;
+        reply.elapsedMs = m_clock.elapsed();
+        m_fi.reportResult(reply);
+        m_fi.reportFinished();
+        emit (m_owner->*m_signal)(reply);
+    }
+
+    Signal m_signal;
+    QFutureInterface<NetshReply<T>> m_fi;
+    QFutureWatcher<NetshReply<T>> m_watcher;
+};
+
+NetshWlanAsync::NetshWlanAsync(QObject *parent)
+    : QObject(parent)
+{
+    qRegisterMetaType<NetshReply<WifiInfo>>("NetshReply<WifiInfo>");
+    qRegisterMetaType<NetshReply<QStringList>>("NetshReply<QStringList>");
+    qRegisterMetaType<NetshReply<bool>>("NetshReply<bool>");
+}
+
+NetshWlanAsync::~NetshWlanAsync()
+{
+    cancelAll();
+}
+
+void NetshWlanAsync::setCommandShell(const QString &program, const QStringList &arguments)
+{
+    m_shellProgram = program;
+    m_shellArguments = arguments;
+}
+
+void NetshWlanAsync::cancelAll()
+{
+    const QSet<OpBase *> ops = m_ops;
+    for (OpBase *op : ops)
+        op->cancel();
+}
+
+template <class T>
+NetshWlanAsync::Op<T> *NetshWlanAsync::begin(int deadlineMs, void (NetshWlanAsync::*signal)(const NetshReply<T> &))
+{
+    Op<T> *op = new Op<T>(this, deadlineMs, signal);
+    m_ops.insert(op);
+    return op;
+}
+
+void NetshWlanAsync::wifiStep(OpBase *op, WifiInfo *info, const std::function<void(bool)> &next)
+{
+    // 有信息后端时不起进程（连接确认里的轮询也走这里）
+    if (const std::shared_ptr<IWlanBackend> backend = NetshWlanReader::backend()) {
+        next(backend->queryWifi(*info, nullptr));
+        return;
+    }
+    op->run("netsh wlan show interfaces", 8000, [info, next](const QString &out) {
+        if (out.isEmpty()) {
+            next(false);
+            return;
+        }
+        NetshOutputParser::parseWlanInterfaces(out, *info);
+        next(true);
+    });
+}
+
+// 一轮 IP 探测的状态：三条命令同时跑，先解析出结果的为准
+struct NetshWlanAsync::IpRace
+{
+    QString iface;
+    WifiInfo *io = nullptr;
+    DoneFn done;
+    int  pending = 0;
+    bool settled = false;
+
+    // 投机提前起的 ipconfig（queryAll 里和 WiFi 查询一起跑，那时还不知道接口名）
+    bool    ipconfigStarted = false;
+    bool    ipconfigFinished = false;
+    QString ipconfigOut;
+};
+
+std::shared_ptr<NetshWlanAsync::IpRace> NetshWlanAsync::startIpconfig(OpBase *op)
+{
+    std::shared_ptr<IpRace> race = std::make_shared<IpRace>();
+    race->ipconfigStarted = true;
+    op->run(NetshWlanReader::ipProbeCommand(NetshWlanReader::ProbeIpconfig, QString()), 8000,
+            [op, race](const QString &out) {
+        race->ipconfigFinished = true;
+        race->ipconfigOut = out;
+        if (race->done) onIpProbe(op, race, NetshWlanReader::ProbeIpconfig, out); // 已经在等结果了
+    });
+    return race;
+}
+
+void NetshWlanAsync::onIpProbe(OpBase *op, const std::shared_ptr<IpRace> &race, int probe, const QString &out)
+{
+    if (race->settled) return;
+    --race->pending;
+
+    WifiInfo got;
+    if (NetshWlanReader::parseIpProbe(NetshWlanReader::IpProbe(probe), out, race->iface, got)) {
+        race->settled = true;
+        race->io->ipv4 = got.ipv4;
+        race->io->gateway = got.gateway;
+        op->stopProcesses(); // 其余的不用等了
+        race->done(true);
+        return;
+    }
+    if (race->pending == 0) {
+        race->settled = true;
+        race->done(false);
+    }
+}
+
+// 同 NetshWlanReader::raceIpProbes：netsh ipv4 / netsh ip / ipconfig 同时跑
+void NetshWlanAsync::ipSteps(OpBase *op, const QString &iface, WifiInfo *io, const DoneFn &done,
+                             std::shared_ptr<IpRace> race)
+{
+    io->ipv4.clear();
+    io->gateway.clear();
+
+    if (!race) race = std::make_shared<IpRace>();
+    race->iface = iface;
+    race->io = io;
+    race->done = done;
+
+    const NetshWlanReader::IpProbe netshProbes[] = { NetshWlanReader::ProbeNetshIpv4, NetshWlanReader::ProbeNetshIp };
+    race->pending = 2;
+    if (!race->ipconfigStarted) {
+        race->ipconfigStarted = true;
+        ++race->pending;
+        op->run(NetshWlanReader::ipProbeCommand(NetshWlanReader::ProbeIpconfig, iface), 8000,
+                [op, race](const QString &out) { onIpProbe(op, race, NetshWlanReader::ProbeIpconfig, out); });
+    } else if (!race->ipconfigFinished) {
+        ++race->pending; // 结果到了由 startIpconfig 的回调转过来
+    }
+
+    for (NetshWlanReader::IpProbe probe : netshProbes) {
+        op->run(NetshWlanReader::ipProbeCommand(probe, iface), 8000,
+                [op, race, probe](const QString &out) { onIpProbe(op, race, probe, out); });
+    }
+
+    // 投机的 ipconfig 已经跑完：直接拿来解析（成功的话两条 netsh 刚起就被杀掉）
+    if (race->ipconfigFinished) {
+        ++race->pending;
+        onIpProbe(op, race, NetshWlanReader::ProbeIpconfig, race->ipconfigOut);
+    }
+}
+
+// 设置了信息后端（NetshWlanReader::backend）时直接在本线程查：读文件 + ioctl，不起进程，不会卡住
+// 查询推迟到调用返回之后再做（期间取消或超时就不查了），结果照常从事件循环交付
+bool NetshWlanAsync::viaBackend(Op<WifiInfo> *op, const BackendFn &fn)
+{
+    const std::shared_ptr<IWlanBackend> backend = NetshWlanReader::backend();
+    if (!backend) return false;
+    op->after(0, [op, backend, fn]() {
+        QString errorText;
+        if (fn(*backend, op->reply.value, &errorText))
+            op->succeed();
+        else
+            op->fail(errorText);
+    });
+    return true;
+}
+
+QFuture<NetshReply<WifiInfo>> NetshWlanAsync::queryWifi(int deadlineMs)
+{
+    Op<WifiInfo> *op = begin(deadlineMs, &NetshWlanAsync::wifiReady);
+    const QFuture<NetshReply<WifiInfo>> f = op->future();
+    if (viaBackend(op, [](IWlanBackend &b, WifiInfo &info, QString *err) { return b.queryWifi(info, err); }))
+        return f;
+    wifiStep(op, &op->reply.value, [op](bool gotOutput) {
+        if (gotOutput)
+            op->succeed();
+        else
+            op->fail("netsh wlan show interfaces 无输出（可能超时或 WLAN 服务异常）");
+    });
+    return f;
+}
+
+QFuture<NetshReply<WifiInfo>> NetshWlanAsync::queryIpForInterface(const QString &interfaceName, int deadlineMs)
+{
+    Op<WifiInfo> *op = begin(deadlineMs, &NetshWlanAsync::ipReady);
+    const QFuture<NetshReply<WifiInfo>> f = op->future();
+    if (interfaceName.trimmed().isEmpty()) {
+        op->after(0, [op]() { op->fail("interfaceName 为空，无法定向解析 IP/网关"); });
+        return f;
+    }
+
+    op->reply.value.interfaceName = interfaceName;
+    if (viaBackend(op, [interfaceName](IWlanBackend &b, WifiInfo &io, QString *err) {
+            return b.queryIpForInterface(interfaceName, io, err);
+        }))
+        return f;
+    ipSteps(op, interfaceName, &op->reply.value, [op](bool ok) {
+        if (ok)
+            op->succeed();
+        else
+            op->fail("未能解析到 IPv4/默认网关（netsh/ipconfig 均失败）。");
+    });
+    return f;
+}
+
+QFuture<NetshReply<WifiInfo>> NetshWlanAsync::queryAll(int deadlineMs)
+{
+    Op<WifiInfo> *op = begin(deadlineMs, &NetshWlanAsync::wifiReady);
+    const QFuture<NetshReply<WifiInfo>> f = op->future();
+    if (viaBackend(op, [](IWlanBackend &b, WifiInfo &info, QString *err) { return b.queryAll(info, err); }))
+        return f;
+    // ipconfig 不依赖接口名，和 WiFi 查询一起投机启动
+    const std::shared_ptr<IpRace> race = startIpconfig(op);
+    wifiStep(op, &op->reply.value, [this, op, race](bool gotOutput) {
+        if (!gotOutput) {
+            op->fail("netsh wlan show interfaces 无输出（可能超时或 WLAN 服务异常）");
+            return;
+        }
+        if (op->reply.value.interfaceName.isEmpty()) {
+            op->succeed();
+            return;
+        }
+        // IP 失败不影响 WiFi 主信息
+        ipSteps(op, op->reply.value.interfaceName, &op->reply.value, [op](bool) { op->succeed(); }, race);
+    });
+    return f;
+}
+
+QFuture<NetshReply<QStringList>> NetshWlanAsync::profiles(int deadlineMs)
+{
+    Op<QStringList> *op = begin(deadlineMs, &NetshWlanAsync::profilesReady);
+    const QFuture<NetshReply<QStringList>> f = op->future();
+    op->run("netsh wlan show profiles", 8000, [op](const QString &out) {
+        if (out.isEmpty()) {
+            op->fail("netsh wlan show profiles 无输出");
+            return;
+        }
+        op->reply.value = NetshOutputParser::parseProfiles(out);
+        if (op->reply.value.isEmpty())
+            op->fail("未解析到 WiFi 配置文件（可能未保存过 WiFi）。");
+        else
+            op->succeed();
+    });
+    return f;
+}
+
+// ---------- 连接/断开确认：命令没明确报成功时，等接口状态变成目标 ----------
+// Check：查一次 WiFi，满足 done 就立刻完成（不用等到下一个间隔）
+// Sleep：后端有变化通知时等通知（maxMs 兜底再查），没有就退避（initialMs 起、乘 factor、封顶 maxMs）
+// Check 途中来了通知，查完不满足时马上再查一次；预算用完还不满足就失败
+struct NetshWlanAsync::LinkWait
+{
+    std::function<bool(const WifiInfo &)> done;
+    QString failText;
+    NetshWlanReader::ConfirmBackoff backoff;
+    int budgetMs = 0;
+    QElapsedTimer clock;
+    int delayMs = 0;
+
+    bool started = false;  // 命令已经跑完，进入确认
+    bool checking = false;
+    bool changed = false;  // 有还没处理的变化通知
+    quint64 sleepGen = 0;  // 每次 Sleep 一个编号：通知提前唤醒后，旧的兜底定时器作废
+    std::unique_ptr<IWlanBackend::ChangeWatch> watch;
+};
+
+std::shared_ptr<NetshWlanAsync::LinkWait> NetshWlanAsync::openLinkWait(Op<bool> *op)
+{
+    std::shared_ptr<LinkWait> w = std::make_shared<LinkWait>();
+    w->backoff = NetshWlanReader::confirmBackoff();
+    if (const std::shared_ptr<IWlanBackend> backend = NetshWlanReader::backend())
+        w->watch = backend->watchChanges();
+    if (!w->watch) return w;
+
+    // 通知器归 op 管：op 结束时一起删，lambda 里的 w 随之释放
+    QSocketNotifier *notifier = new QSocketNotifier(w->watch->fd(), QSocketNotifier::Read, op);
+    connect(notifier, &QSocketNotifier::activated, op, [this, op, w]() {
+        w->watch->drain();
+        if (!w->started || w->checking) {
+            w->changed = true;
+            return;
+        }
+        ++w->sleepGen;
+        linkCheck(op, w);
+    });
+    return w;
+}
+
+void NetshWlanAsync::linkStart(Op<bool> *op, const std::shared_ptr<LinkWait> &w)
+{
+    w->started = true;
+    w->clock.start();
+    w->delayMs = w->backoff.initialMs;
+    linkSleep(op, w);
+}
+
+void NetshWlanAsync::linkCheck(Op<bool> *op, const std::shared_ptr<LinkWait> &w)
+{
+    w->checking = true;
+    w->changed = false;
+    std::shared_ptr<WifiInfo> cur = std::make_shared<WifiInfo>();
+    wifiStep(op, cur.get(), [this, op, w, cur](bool) {
+        w->checking = false;
+        if (w->done(*cur)) {
+            op->reply.value = true;
+            op->succeed();
+            return;
+        }
+        if (w->clock.elapsed() >= w->budgetMs) {
+            op->fail(w->failText);
+            return;
+        }
+        linkSleep(op, w);
+    });
+}
+
+void NetshWlanAsync::linkSleep(Op<bool> *op, const std::shared_ptr<LinkWait> &w)
+{
+    if (w->changed) {
+        linkCheck(op, w);
+        return;
+    }
+    const int left = w->budgetMs - int(w->clock.elapsed());
+    if (left <= 0) {
+        op->fail(w->failText);
+        return;
+    }
+
+    int ms = w->backoff.maxMs;
+    if (!w->watch) {
+        ms = w->delayMs;
+        w->delayMs = w->backoff.next(w->delayMs);
+    }
+    const quint64 gen = ++w->sleepGen;
+    op->after(qMin(left, ms), [this, op, w, gen]() {
+        if (gen == w->sleepGen) linkCheck(op, w);
+    });
+}
+
+QFuture<NetshReply<bool>> NetshWlanAsync::connectToProfile(const QString &profileName,
+                                                           const QString &ssid,
+                                                           const QString &interfaceName,
+                                                           int deadlineMs)
+{
+    Op<bool> *op = begin(deadlineMs, &NetshWlanAsync::connectFinished);
+    const QFuture<NetshReply<bool>> f = op->future();
+    if (profileName.trimmed().isEmpty()) {
+        op->after(0, [op]() { op->fail("profileName 不能为空"); });
+        return f;
+    }
+
+    // 命令之前就订阅接口变化，免得漏掉命令执行期间的通知
+    const std::shared_ptr<LinkWait> w = openLinkWait(op);
+    w->done = [ssid](const WifiInfo &cur) { return NetshWlanReader::connectConfirmed(cur, ssid); };
+    w->budgetMs = w->backoff.connectBudgetMs;
+
+    const QString cmd = NetshWlanReader::connectCommand(profileName, ssid, interfaceName);
+    op->run(cmd, 12000, [this, op, w](const QString &out) {
+        if (NetshWlanReader::looksLikeSuccessConnectOutput(out)) {
+            op->reply.value = true;
+            op->succeed();
+            return;
+        }
+        w->failText = out.trimmed();
+        if (w->failText.isEmpty()) w->failText = "连接失败（无命令输出）。建议：传入 ssid 参数或检查 profile 是否可用。";
+        linkStart(op, w);
+    });
+    return f;
+}
+
+QFuture<NetshReply<bool>> NetshWlanAsync::disconnect(const QString &interfaceName, int deadlineMs)
+{
+    Op<bool> *op = begin(deadlineMs, &NetshWlanAsync::disconnectFinished);
+    const QFuture<NetshReply<bool>> f = op->future();
+    const std::shared_ptr<LinkWait> w = openLinkWait(op);
+    w->done = [](const WifiInfo &cur) { return !cur.connected; };
+    w->budgetMs = w->backoff.disconnectBudgetMs;
+
+    op->run(NetshWlanReader::disconnectCommand(interfaceName), 8000, [this, op, w](const QString &out) {
+        if (NetshWlanReader::looksLikeDisconnectOutput(out)) {
+            op->reply.value = true;
+            op->succeed();
+            return;
+        }
+        w->failText = out.trimmed();
+        if (w->failText.isEmpty()) w->failText = "断开失败（无命令输出）。";
+        linkStart(op, w);
+    });
+    return f;
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <QObject>
+#include <QFuture>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+#include <memory>
+
+#include "NetshWlanReaderV.h"
+
+class IWlanBackend;
+
+// 异步调用的结果；ok=false 时看 errorText，timedOut 表示整体截止时间到了
+// 调用方 future.cancel() 或 cancelAll() 取消时 future 处于 canceled 状态、没有结果
+template <class T>
+struct NetshReply
+{
+    T       value{};
+    bool    ok = false;
+    bool    timedOut = false;
+    QString errorText;
+    qint64  elapsedMs = -1; // 调用到完成的耗时（connectToProfile 即连上所用时间）
+};
+Q_DECLARE_METATYPE(NetshReply<WifiInfo>)
+Q_DECLARE_METATYPE(NetshReply<QStringList>)
+Q_DECLARE_METATYPE(NetshReply<bool>)
+
+// NetshWlanReader 的异步版：全部由 QProcess 信号驱动，没有任何 waitFor / msleep，
+// 可以直接在 GUI 线程上用。每个调用都有一个整体截止时间（含内部的多条命令和连接后的轮询），
+// 单条命令的超时和同步版一致（到了就当无输出，走同样的兜底逻辑）；deadlineMs <= 0 表示不设整体截止。
+// 对象和回调都在创建它的线程上（需要事件循环）。结果（future 和信号）总是在调用返回之后从事件循环里交付，
+// 参数不对、走信息后端这些不起进程的情况也一样，调用方拿到 future 之后还来得及连信号、取消。
+class NetshWlanAsync : public QObject
+{
+    Q_OBJECT
+public:
+    explicit NetshWlanAsync(QObject *parent = nullptr);
+    ~NetshWlanAsync() override; // 还没完成的全部取消（杀掉子进程）
+
+    // 一次性获取：WiFi + IP
+    QFuture<NetshReply<WifiInfo>> queryAll(int deadlineMs = 30000);
+
+    // 仅 WiFi（netsh wlan show interfaces）
+    QFuture<NetshReply<WifiInfo>> queryWifi(int deadlineMs = 8000);
+
+    // 仅 IP：结果里只填 interfaceName / ipv4 / gateway
+    QFuture<NetshReply<WifiInfo>> queryIpForInterface(const QString &interfaceName, int deadlineMs = 25000);
+
+    // 已保存的 WiFi 配置文件
+    QFuture<NetshReply<QStringList>> profiles(int deadlineMs = 8000);
+
+    // 切换 WiFi；命令没报成功时按 NetshWlanReader::confirmBackoff() 确认（有变化通知时等通知），目标 SSID 一出现就完成
+    QFuture<NetshReply<bool>> connectToProfile(const QString &profileName,
+                                               const QString &ssid = QString(),
+                                               const QString &interfaceName = QString(),
+                                               int deadlineMs = 30000);
+
+    // 断开 WiFi（确认方式同上）
+    QFuture<NetshReply<bool>> disconnect(const QString &interfaceName = QString(),
+                                         int deadlineMs = 20000);
+
+    void cancelAll();
+    int pendingCount() const { return m_ops.size(); }
+
+    // 起命令用的程序：默认 cmd /c <命令>，arguments 放在命令前面；只影响之后发起的调用
+    void setCommandShell(const QString &program, const QStringList &arguments);
+
+signals:
+    // 和 future 同时交付，方便直接连槽（取消的调用不发）
+    void wifiReady(const NetshReply<WifiInfo> &reply);
+    void ipReady(const NetshReply<WifiInfo> &reply);
+    void profilesReady(const NetshReply<QStringList> &reply);
+    void connectFinished(const NetshReply<bool> &reply);
+    void disconnectFinished(const NetshReply<bool> &reply);
+
+private:
+    class OpBase;
+    template <class T> class Op;
+
+    using OutputFn = std::function<void(const QString &out)>;
+    using DoneFn = std::function<void(bool ok)>;
+
+    template <class T>
+    Op<T> *begin(int deadlineMs, void (NetshWlanAsync::*signal)(const NetshReply<T> &));
+
+    // 以下都在某个操作内串命令；操作结束（完成/超时/取消）后的回调不会再被调用
+    void wifiStep(OpBase *op, WifiInfo *info, const std::function<void(bool gotOutput)> &next);
+    struct IpRace;
+    std::shared_ptr<IpRace> startIpconfig(OpBase *op);
+    static void onIpProbe(OpBase *op, const std::shared_ptr<IpRace> &race, int probe, const QString &out);
+    void ipSteps(OpBase *op, const QString &iface, WifiInfo *io, const DoneFn &done,
+                 std::shared_ptr<IpRace> race = nullptr);
+    using BackendFn = std::function<bool(IWlanBackend &backend, WifiInfo &info, QString *errorText)>;
+    bool viaBackend(Op<WifiInfo> *op, const BackendFn &fn);
+
+    // 连接/断开后的确认状态机（见 cpp）
+    struct LinkWait;
+    std::shared_ptr<LinkWait> openLinkWait(Op<bool> *op);
+    void linkStart(Op<bool> *op, const std::shared_ptr<LinkWait> &w);
+    void linkCheck(Op<bool> *op, const std::shared_ptr<LinkWait> &w);
+    void linkSleep(Op<bool> *op, const std::shared_ptr<LinkWait> &w);
+
+    QSet<OpBase *> m_ops;
+    QString     m_shellProgram = "cmd";
+    QStringList m_shellArguments = {"/c"};
+};
@@ -1,212 +1,207 @@
 #include "NetshWlanReaderV.h"
+#include "CmdSession.h"
+#include "NetshOutputParser.h"
+#include "WlanBackend.h"
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QProcess>
 #include <QThread>
 #include <QtGlobal>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+QMutex g_sessionMutex;
+std::shared_ptr<ICmdSession> g_session;
+
+QMutex g_backendMutex;
+std::shared_ptr<IWlanBackend> g_backend
+#ifdef Q_OS_LINUX
+    = std::make_shared<LinuxWlanBackend>() // Linux 上没有 netsh
+#endif
+    ;
+
+QMutex g_backoffMutex;
+NetshWlanReader::ConfirmBackoff g_backoff;
+}
 
-QString NetshWlanReader::runCmd(const QString &cmd, int timeoutMs)
+void NetshWlanReader::setCmdSession(std::shared_ptr<ICmdSession> session)
 {
-    QProcess p;
-    p.start("cmd", {"/c", cmd});
-    if (!p.waitForFinished(timeoutMs)) {
-        p.kill();
-        p.waitForFinished(1000);
-        return QString();
-    }
-    return QString::fromLocal8Bit(p.readAllStandardOutput());
+    QMutexLocker lock(&g_sessionMutex);
+    g_session = std::move(session);
 }
 
-QString NetshWlanReader::valueAfterColon(const QString &line)
+std::shared_ptr<ICmdSession> NetshWlanReader::cmdSession()
 {
-    int idx = line.indexOf(':');
-    if (idx < 0) idx = line.indexOf(QChar(0xFF1A)); // 全角：
-    if (idx < 0) return QString();
-    return line.mid(idx + 1).trimmed();
+    QMutexLocker lock(&g_sessionMutex);
+    return g_session;
 }
 
-int NetshWlanReader::parseFirstInt(const QString &s)
+void NetshWlanReader::setBackend(std::shared_ptr<IWlanBackend> backend)
 {
-    QString t = s.trimmed();
-    QString num;
-    for (QChar c : t) {
-        if (c.isDigit()) num.append(c);
-        else if (!num.isEmpty()) break;
-    }
-    return num.isEmpty() ? -1 : num.toInt();
+    QMutexLocker lock(&g_backendMutex);
+    g_backend = std::move(backend);
 }
 
-int NetshWlanReader::parsePercent(const QString &s)
+std::shared_ptr<IWlanBackend> NetshWlanReader::backend()
 {
-    return parseFirstInt(s);
+    QMutexLocker lock(&g_backendMutex);
+    return g_backend;
 }
 
-bool NetshWlanReader::textIsConnected(const QString &stateText)
+void NetshWlanReader::setConfirmBackoff(const ConfirmBackoff &backoff)
 {
-    if (stateText.contains("已连接")) return true;
-    if (stateText.contains("connected", Qt::CaseInsensitive)) return true;
-    return false;
+    ConfirmBackoff b = backoff;
+    if (b.initialMs < 1) b.initialMs = 1;
+    if (b.factor < 1.0) b.factor = 1.0;
+    if (b.maxMs < b.initialMs) b.maxMs = b.initialMs;
+    if (b.connectBudgetMs < 0) b.connectBudgetMs = 0;
+    if (b.disconnectBudgetMs < 0) b.disconnectBudgetMs = 0;
+
+    QMutexLocker lock(&g_backoffMutex);
+    g_backoff = b;
 }
 
-void NetshWlanReader::parseWlanInterfaces(const QString &output, WifiInfo &info)
+NetshWlanReader::ConfirmBackoff NetshWlanReader::confirmBackoff()
 {
-    // 防止残留
-    info.signalPct   = -1;
-    info.phyRateMbps = -1;
-    info.rxRateMbps  = -1;
-    info.txRateMbps  = -1;
-
-    const QStringList lines = output.split('\n');
-
-    for (QString line : lines) {
-        line = line.trimmed();
-        if (line.isEmpty()) continue;
-
-        if (line.startsWith("名称") || line.startsWith("Name")) {
-            info.interfaceName = valueAfterColon(line);
-            continue;
-        }
-
-        if (line.startsWith("说明") || line.startsWith("Description")) {
-            info.interfaceDesc = valueAfterColon(line);
-            continue;
-        }
-
-        if (line.startsWith("状态") || line.startsWith("State")) {
-            info.state = valueAfterColon(line);
-            info.connected = textIsConnected(info.state);
-            continue;
-        }
+    QMutexLocker lock(&g_backoffMutex);
+    return g_backoff;
+}
 
-        if (line.startsWith("SSID") && !line.startsWith("BSSID")) {
-            info.ssid = valueAfterColon(line);
-            continue;
-        }
+QString NetshWlanReader::runCmd(const QString &cmd, int timeoutMs)
+{
+    if (const std::shared_ptr<ICmdSession> session = cmdSession())
+        return session->run(cmd, timeoutMs);
 
-        if (line.startsWith("BSSID")) {
-            info.bssid = valueAfterColon(line);
-            continue;
-        }
+    QProcess p;
+    p.start("cmd", {"/c", cmd});
+    if (!p.waitForFinished(timeoutMs)) {
+        p.kill();
+        p.waitForFinished(1000);
+        return QString();
+    }
+    return QString::fromLocal8Bit(p.readAllStandardOutput());
+}
 
-        if (line.startsWith("物理地址") || line.startsWith("Physical address")) {
-            info.mac = valueAfterColon(line);
-            continue;
-        }
+// 同时跑的一组 cmd /c 子进程，每条有自己的超时（同 runCmd）；析构时杀掉还没结束的
+// 设置了命令会话时没法同时跑：start 只记下命令，next 按 start 的顺序在会话里逐条执行
+class NetshWlanReader::CmdRace
+{
+public:
+    CmdRace()
+        : m_session(cmdSession())
+    {
+    }
 
-        if (line.startsWith("信号") || line.startsWith("Signal")) {
-            info.signalPct = parsePercent(valueAfterColon(line));
-            continue;
+    ~CmdRace()
+    {
+        for (Entry &e : m_entries) {
+            if (e.taken || !e.proc) continue;
+            e.proc->kill();
+            e.proc->waitForFinished(1000);
         }
+    }
 
-        // ✅ 接收速率(Mbps)
-        if (line.startsWith("接收速率") || line.startsWith("Receive rate")) {
-            if (info.rxRateMbps < 0)
-                info.rxRateMbps = parseFirstInt(valueAfterColon(line));
-            continue;
+    int start(const QString &cmd, int timeoutMs = 8000)
+    {
+        Entry e;
+        e.timeoutMs = timeoutMs;
+        if (m_session) {
+            e.cmd = cmd;
+        } else {
+            e.proc.reset(new QProcess);
+            e.clock.start();
+            e.proc->start("cmd", {"/c", cmd});
         }
+        m_entries.push_back(std::move(e));
+        return int(m_entries.size()) - 1;
+    }
 
-        // ✅ 传输速率(Mbps)
-        if (line.startsWith("传输速率") || line.startsWith("Transmit rate")) {
-            if (info.txRateMbps < 0)
-                info.txRateMbps = parseFirstInt(valueAfterColon(line));
-            continue;
+    // 等任意一条结束，返回下标；out 为输出（超时或启动失败时为空）。都取走了返回 -1
+    int next(QString &out)
+    {
+        if (m_session) {
+            for (size_t i = 0; i < m_entries.size(); ++i) {
+                Entry &e = m_entries[i];
+                if (e.taken) continue;
+                e.taken = true;
+                out = m_session->run(e.cmd, e.timeoutMs);
+                return int(i);
+            }
+            return -1;
         }
 
-        // ✅ PHY/协商速率(Mbps)（很多机器没有这行，留空很正常）
-        if (line.startsWith("速率") || line.startsWith("Rate")) {
-            // 双保险：避免未来字段名变化误伤 RX/TX
-            if (!line.startsWith("接收速率") && !line.startsWith("传输速率") &&
-                !line.startsWith("Receive rate") && !line.startsWith("Transmit rate")) {
-                if (info.phyRateMbps < 0)
-                    info.phyRateMbps = parseFirstInt(valueAfterColon(line));
+        for (;;) {
+            bool pending = false;
+            for (size_t i = 0; i < m_entries.size(); ++i) {
+                Entry &e = m_entries[i];
+                if (e.taken) continue;
+                pending = true;
+                if (e.proc->state() == QProcess::NotRunning || e.proc->waitForFinished(0)) {
+                    e.taken = true;
+                    out = QString::fromLocal8Bit(e.proc->readAllStandardOutput());
+                    return int(i);
+                }
+                if (e.clock.hasExpired(e.timeoutMs)) {
+                    e.proc->kill();
+                    e.proc->waitForFinished(1000);
+                    e.taken = true;
+                    out.clear();
+                    return int(i);
+                }
             }
-            continue;
+            if (!pending) return -1;
+            QThread::msleep(5);
         }
     }
 
-    // 兜底：有 SSID 就认为连接（有些系统 state 不稳定）
-    if (!info.connected && !info.ssid.isEmpty() && info.ssid != "-") {
-        info.connected = true;
-        if (info.state.isEmpty()) info.state = "已连接";
-    }
-}
+private:
+    struct Entry {
+        std::unique_ptr<QProcess> proc; // 不走会话时
+        QString cmd;                    // 走会话时
+        QElapsedTimer clock;
+        int  timeoutMs = 8000;
+        bool taken = false;
+    };
+    std::shared_ptr<ICmdSession> m_session;
+    std::vector<Entry> m_entries;
+};
 
 WifiInfo NetshWlanReader::queryWifi(QString *errorText)
 {
     WifiInfo info;
+    if (const std::shared_ptr<IWlanBackend> b = backend()) {
+        b->queryWifi(info, errorText);
+        return info;
+    }
+
     const QString out = runCmd("netsh wlan show interfaces", 8000);
     if (out.isEmpty()) {
         if (errorText) *errorText = "netsh wlan show interfaces 无输出（可能超时或 WLAN 服务异常）";
         return info;
     }
-    parseWlanInterfaces(out, info);
+    NetshOutputParser::parseWlanInterfaces(out, info);
     return info;
 }
 
-bool NetshWlanReader::parseIpByNetsh(const QString &iface, WifiInfo &io)
+QString NetshWlanReader::ipProbeCommand(IpProbe probe, const QString &iface)
 {
-    QString out = runCmd(QString("netsh interface ipv4 show config name=\"%1\"").arg(iface), 8000);
-    if (out.isEmpty())
-        out = runCmd(QString("netsh interface ip show config name=\"%1\"").arg(iface), 8000);
-    if (out.isEmpty())
-        return false;
-
-    const QStringList lines = out.split('\n');
-    for (QString line : lines) {
-        line = line.trimmed();
-        if (line.isEmpty()) continue;
-
-        if (line.contains("IP 地址") || line.contains("IP Address")) {
-            const QString v = valueAfterColon(line);
-            if (!v.isEmpty()) io.ipv4 = v;
-            continue;
-        }
-
-        if (line.contains("默认网关") || line.contains("Default Gateway")) {
-            const QString v = valueAfterColon(line);
-            if (!v.isEmpty() && v != "无") io.gateway = v;
-            continue;
-        }
+    switch (probe) {
+    case ProbeNetshIpv4: return QString("netsh interface ipv4 show config name=\"%1\"").arg(iface);
+    case ProbeNetshIp:   return QString("netsh interface ip show config name=\"%1\"").arg(iface);
+    case ProbeIpconfig:  break;
     }
-
-    return !io.ipv4.isEmpty() || !io.gateway.isEmpty();
+    return "ipconfig";
 }
 
-bool NetshWlanReader::parseIpByIpconfig(const QString &iface, WifiInfo &io)
+bool NetshWlanReader::parseIpProbe(IpProbe probe, const QString &output, const QString &iface, WifiInfo &io)
 {
-    const QString out = runCmd("ipconfig", 8000);
-    if (out.isEmpty()) return false;
-
-    const QStringList lines = out.split('\n');
-    int start = -1;
-    for (int i = 0; i < lines.size(); ++i) {
-        if (lines[i].contains(iface, Qt::CaseInsensitive)) {
-            start = i;
-            break;
-        }
-    }
-    if (start < 0) return false;
-
-    int end = lines.size();
-    for (int i = start + 1; i < lines.size(); ++i) {
-        const QString t = lines[i].trimmed();
-        if (t.isEmpty()) { end = i; break; }
-        if (t.contains("适配器") || t.contains("adapter", Qt::CaseInsensitive)) { end = i; break; }
-    }
-
-    for (int i = start; i < end; ++i) {
-        QString line = lines[i].trimmed();
-        if (line.isEmpty()) continue;
-
-        if (line.contains("IPv4") || line.contains("IPv4 Address")) {
-            io.ipv4 = valueAfterColon(line);
-            continue;
-        }
-        if (line.contains("默认网关") || line.contains("Default Gateway")) {
-            const QString v = valueAfterColon(line);
-            if (!v.isEmpty() && v != "无") io.gateway = v;
-            continue;
-        }
-    }
-    return !io.ipv4.isEmpty() || !io.gateway.isEmpty();
+    if (output.isEmpty()) return false;
+    if (probe == ProbeIpconfig) return NetshOutputParser::parseIpconfig(output, iface, io);
+    return NetshOutputParser::parseNetshIpConfig(output, io);
 }
 
 bool NetshWlanReader::queryIpForInterface(const QString &interfaceName, WifiInfo &io, QString *errorText)
@@ -216,45 +211,88 @@ bool NetshWlanReader::queryIpForInterface(const QString &interfaceName, WifiInfo
         return false;
     }
 
+    if (const std::shared_ptr<IWlanBackend> b = backend())
+        return b->queryIpForInterface(interfaceName, io, errorText);
+
     io.ipv4.clear();
     io.gateway.clear();
 
-    if (parseIpByNetsh(interfaceName, io))
-        return true;
-
-    if (parseIpByIpconfig(interfaceName, io))
+    CmdRace race;
+    if (raceIpProbes(race, interfaceName, io))
         return true;
 
     if (errorText) *errorText = "未能解析到 IPv4/默认网关（netsh/ipconfig 均失败）。";
     return false;
 }
 
-WifiInfo NetshWlanReader::queryAll(QString *errorText)
+bool NetshWlanReader::raceIpProbes(CmdRace &race, const QString &iface, WifiInfo &io,
+                                   int ipconfigIdx, const QString *ipconfigOut)
 {
-    WifiInfo info = queryWifi(errorText);
-    if (!info.interfaceName.isEmpty()) {
-        QString ipErr;
-        queryIpForInterface(info.interfaceName, info, &ipErr);
-        (void)ipErr; // IP 失败不影响 WiFi 主信息
+    WifiInfo got;
+    if (ipconfigOut && parseIpProbe(ProbeIpconfig, *ipconfigOut, iface, got)) {
+        io.ipv4 = got.ipv4;
+        io.gateway = got.gateway;
+        return true;
     }
-    return info;
+
+    QHash<int, IpProbe> probes;
+    if (!ipconfigOut)
+        probes.insert(ipconfigIdx >= 0 ? ipconfigIdx : race.start(ipProbeCommand(ProbeIpconfig, iface)), ProbeIpconfig);
+    probes.insert(race.start(ipProbeCommand(ProbeNetshIpv4, iface)), ProbeNetshIpv4);
+    probes.insert(race.start(ipProbeCommand(ProbeNetshIp, iface)), ProbeNetshIp);
+
+    // 先解析出结果的为准，其余的由 race 析构时杀掉
+    QString out;
+    int idx;
+    while ((idx = race.next(out)) >= 0) {
+        if (!probes.contains(idx)) continue;
+        got = WifiInfo();
+        if (parseIpProbe(probes.value(idx), out, iface, got)) {
+            io.ipv4 = got.ipv4;
+            io.gateway = got.gateway;
+            return true;
+        }
+    }
+    return false;
 }
 
-QStringList NetshWlanReader::parseProfiles(const QString &output)
+WifiInfo NetshWlanReader::queryAll(QString *errorText)
 {
-    QStringList list;
-    const QStringList lines = output.split('\n');
-    for (QString line : lines) {
-        line = line.trimmed();
-        if (line.isEmpty()) continue;
-
-        if (line.contains("所有用户配置文件") || line.contains("All User Profile")) {
-            const QString name = valueAfterColon(line);
-            if (!name.isEmpty()) list << name;
+    WifiInfo info;
+    if (const std::shared_ptr<IWlanBackend> b = backend()) {
+        b->queryAll(info, errorText);
+        return info;
+    }
+
+    // ipconfig 不依赖接口名，和 WiFi 查询一起投机启动；接口名出来后再起两条 netsh 一起抢
+    CmdRace race;
+    const int wifiIdx = race.start("netsh wlan show interfaces", 8000);
+    const int ipconfigIdx = race.start(ipProbeCommand(ProbeIpconfig, QString()), 8000);
+
+    QString out, wifiOut, ipconfigOut;
+    bool ipconfigDone = false;
+    int idx;
+    while ((idx = race.next(out)) >= 0) {
+        if (idx == wifiIdx) {
+            wifiOut = out;
+            break;
+        }
+        if (idx == ipconfigIdx) {
+            ipconfigOut = out;
+            ipconfigDone = true;
         }
     }
-    list.removeDuplicates();
-    return list;
+
+    if (wifiOut.isEmpty()) {
+        if (errorText) *errorText = "netsh wlan show interfaces 无输出（可能超时或 WLAN 服务异常）";
+        return info;
+    }
+    NetshOutputParser::parseWlanInterfaces(wifiOut, info);
+
+    // IP 失败不影响 WiFi 主信息
+    if (!info.interfaceName.isEmpty())
+        raceIpProbes(race, info.interfaceName, info, ipconfigIdx, ipconfigDone ? &ipconfigOut : nullptr);
+    return info;
 }
 
 QStringList NetshWlanReader::profiles(QString *errorText)
@@ -264,7 +302,7 @@ QStringList NetshWlanReader::profiles(QString *errorText)
         if (errorText) *errorText = "netsh wlan show profiles 无输出";
         return {};
     }
-    const QStringList ps = parseProfiles(out);
+    const QStringList ps = NetshOutputParser::parseProfiles(out);
     if (ps.isEmpty() && errorText)
         *errorText = "未解析到 WiFi 配置文件（可能未保存过 WiFi）。";
     return ps;
@@ -277,39 +315,102 @@ bool NetshWlanReader::looksLikeSuccessConnectOutput(const QString &out)
     return false;
 }
 
-bool NetshWlanReader::connectToProfile(const QString &profileName,
-                                       const QString &ssid,
-                                       const QString &interfaceName,
-                                       QString *errorText)
+bool NetshWlanReader::looksLikeDisconnectOutput(const QString &out)
 {
-    if (profileName.trimmed().isEmpty()) {
-        if (errorText) *errorText = "profileName 不能为空";
-        return false;
-    }
+    if (out.contains("断开", Qt::CaseInsensitive)) return true;
+    if (out.contains("disconnected", Qt::CaseInsensitive)) return true;
+    return false;
+}
+
+// 连接命令没报成功时的二次确认：SSID 已切到目标（未指定目标时只要已连上）
+bool NetshWlanReader::connectConfirmed(const WifiInfo &cur, const QString &targetSsid)
+{
+    const QString target = targetSsid.trimmed();
+    if (!target.isEmpty())
+        return cur.ssid.compare(target, Qt::CaseInsensitive) == 0;
+    return cur.connected && !cur.ssid.isEmpty() && cur.ssid != "-";
+}
 
+QString NetshWlanReader::connectCommand(const QString &profileName,
+                                        const QString &ssid,
+                                        const QString &interfaceName)
+{
     QString cmd = QString("netsh wlan connect name=\"%1\"").arg(profileName);
     if (!ssid.trimmed().isEmpty())
         cmd += QString(" ssid=\"%1\"").arg(ssid);
     if (!interfaceName.trimmed().isEmpty())
         cmd += QString(" interface=\"%1\"").arg(interfaceName);
+    return cmd;
+}
 
-    const QString out = runCmd(cmd, 12000);
-    if (looksLikeSuccessConnectOutput(out))
-        return true;
+QString NetshWlanReader::disconnectCommand(const QString &interfaceName)
+{
+    QString cmd = "netsh wlan disconnect";
+    if (!interfaceName.trimmed().isEmpty())
+        cmd += QString(" interface=\"%1\"").arg(interfaceName);
+    return cmd;
+}
+
+namespace {
+
+// 发命令之前订阅接口变化（后端不支持时为空）
+std::unique_ptr<IWlanBackend::ChangeWatch> openChangeWatch()
+{
+    const std::shared_ptr<IWlanBackend> b = NetshWlanReader::backend();
+    return b ? b->watchChanges() : nullptr;
+}
 
-    // 二次确认：轮询 SSID 是否变更（给系统一点时间切换）
-    const QString target = ssid.trimmed();
-    for (int i = 0; i < 10; ++i) {
-        QThread::msleep(300);
-        WifiInfo cur = queryWifi();
-        if (!target.isEmpty()) {
-            if (cur.ssid.compare(target, Qt::CaseInsensitive) == 0)
-                return true;
+// 查一次，不满足就等（有通知等通知，没有按退避睡），直到满足或超出 budgetMs
+bool waitForLink(const std::function<bool(const WifiInfo &)> &done,
+                 const NetshWlanReader::ConfirmBackoff &backoff, int budgetMs,
+                 IWlanBackend::ChangeWatch *watch)
+{
+    QElapsedTimer clock;
+    clock.start();
+    int delay = backoff.initialMs;
+    for (;;) {
+        const int left = budgetMs - int(clock.elapsed());
+        if (left <= 0) return false;
+        if (watch) {
+            // 通知为主，maxMs 兜底再查一次
+            if (watch->wait(qMin(left, backoff.maxMs))) watch->drain();
         } else {
-            if (cur.connected && !cur.ssid.isEmpty() && cur.ssid != "-")
-                return true;
+            QThread::msleep(qMin(left, delay));
+            delay = backoff.next(delay);
         }
+        if (done(NetshWlanReader::queryWifi())) return true;
     }
+}
+
+} // namespace
+
+bool NetshWlanReader::connectToProfile(const QString &profileName,
+                                       const QString &ssid,
+                                       const QString &interfaceName,
+                                       QString *errorText,
+                                       qint64 *elapsedMs)
+{
+    if (profileName.trimmed().isEmpty()) {
+        if (errorText) *errorText = "profileName 不能为空";
+        return false;
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+    const ConfirmBackoff backoff = confirmBackoff();
+    const std::unique_ptr<IWlanBackend::ChangeWatch> watch = openChangeWatch();
+
+    const QString out = runCmd(connectCommand(profileName, ssid, interfaceName), 12000);
+    bool ok = looksLikeSuccessConnectOutput(out);
+
+    // 二次确认：等 SSID 变成目标（给系统一点时间切换），一出现就返回
+    if (!ok) {
+        ok = waitForLink([&ssid](const WifiInfo &cur) { return connectConfirmed(cur, ssid); },
+                         backoff, backoff.connectBudgetMs, watch.get());
+    }
+    if (elapsedMs) *elapsedMs = clock.elapsed();
+    if (ok)
+        return true;
 
     if (errorText) {
         QString msg = out.trimmed();
@@ -319,21 +420,21 @@ bool NetshWlanReader::connectToProfile(const QString &profileName,
     return false;
 }
 
-bool NetshWlanReader::disconnect(const QString &interfaceName, QString *errorText)
+bool NetshWlanReader::disconnect(const QString &interfaceName, QString *errorText, qint64 *elapsedMs)
 {
-    QString cmd = "netsh wlan disconnect";
-    if (!interfaceName.trimmed().isEmpty())
-        cmd += QString(" interface=\"%1\"").arg(interfaceName);
-
-    const QString out = runCmd(cmd, 8000);
-
-    if (out.contains("断开", Qt::CaseInsensitive) ||
-        out.contains("disconnected", Qt::CaseInsensitive)) {
-        return true;
+    QElapsedTimer clock;
+    clock.start();
+    const ConfirmBackoff backoff = confirmBackoff();
+    const std::unique_ptr<IWlanBackend::ChangeWatch> watch = openChangeWatch();
+
+    const QString out = runCmd(disconnectCommand(interfaceName), 8000);
+    bool ok = looksLikeDisconnectOutput(out);
+    if (!ok) {
+        ok = waitForLink([](const WifiInfo &cur) { return !cur.connected; },
+                         backoff, backoff.disconnectBudgetMs, watch.get());
     }
-
-    WifiInfo cur = queryWifi();
-    if (!cur.connected)
+    if (elapsedMs) *elapsedMs = clock.elapsed();
+    if (ok)
         return true;
 
     if (errorText) {
@@ -2,6 +2,10 @@
 
 #include <QString>
 #include <QStringList>
+#include <memory>
+
+class ICmdSession;
+class IWlanBackend;
 
 struct WifiInfo
 {
@@ -43,33 +47,70 @@ public:
     static QStringList profiles(QString *errorText = nullptr);
 
     // 切换 WiFi：name=profile；ssid 可选强制；interface 可选
+    // 命令没报成功时按 confirmBackoff() 确认，目标 SSID 一出现就返回；elapsedMs = 调用到确认连上的耗时
     static bool connectToProfile(const QString &profileName,
                                  const QString &ssid = QString(),
                                  const QString &interfaceName = QString(),
-                                 QString *errorText = nullptr);
+                                 QString *errorText = nullptr,
+                                 qint64 *elapsedMs = nullptr);
 
-    // 断开 WiFi
+    // 断开 WiFi（确认方式同上）
     static bool disconnect(const QString &interfaceName = QString(),
-                           QString *errorText = nullptr);
+                           QString *errorText = nullptr,
+                           qint64 *elapsedMs = nullptr);
+
+    // 连接/断开后的状态确认：后端支持变化通知（IWlanBackend::watchChanges）时等通知再查，
+    // 否则退避轮询：initialMs 后查第一次，之后间隔乘 factor、封顶 maxMs；超过预算还不满足算失败
+    struct ConfirmBackoff
+    {
+        int    initialMs = 25;
+        double factor    = 1.6;
+        int    maxMs     = 500;
+        int    connectBudgetMs    = 4000;
+        int    disconnectBudgetMs = 2000;
+
+        int next(int delayMs) const { return qMin(maxMs, qMax(delayMs + 1, int(delayMs * factor))); }
+    };
+    // 同步版和 NetshWlanAsync 共用；下一次连接/断开开始生效（正在确认的不变）
+    static void setConfirmBackoff(const ConfirmBackoff &backoff);
+    static ConfirmBackoff confirmBackoff();
 
     // 质量分：0~100（不含状态机，仅作为 UI/告警阈值参考）
     static int rateQuality(const WifiInfo &w);
 
-private:
-    static QString runCmd(const QString &cmd, int timeoutMs = 8000);
-    static QString valueAfterColon(const QString &line);
+    // 命令会话：默认每条命令起一个 cmd /c；设置后（如 ShellCmdSession）所有命令走这个会话，
+    // 同时跑的 IP 探测也改为在会话里依次执行。传 nullptr 恢复默认
+    static void setCmdSession(std::shared_ptr<ICmdSession> session);
+    static std::shared_ptr<ICmdSession> cmdSession();
 
-    static int parseFirstInt(const QString &s);
-    static int parsePercent(const QString &s);
+    // 信息来源后端（WlanBackend.h）：设置后 queryAll / queryWifi / queryIpForInterface 改走后端，
+    // 不再跑 netsh / ipconfig（profiles / 连接 / 断开仍走 netsh）。Linux 上默认是 LinuxWlanBackend，
+    // 其它平台默认没有；传 nullptr 恢复 netsh
+    static void setBackend(std::shared_ptr<IWlanBackend> backend);
+    static std::shared_ptr<IWlanBackend> backend();
 
-    static bool textIsConnected(const QString &stateText);
+private:
+    friend class NetshWlanAsync; // 异步版复用下面的命令拼接和解析
 
-    static void parseWlanInterfaces(const QString &output, WifiInfo &info);
-    static QStringList parseProfiles(const QString &output);
+    static QString runCmd(const QString &cmd, int timeoutMs = 8000);
 
+    // 输出解析见 NetshOutputParser
     static bool looksLikeSuccessConnectOutput(const QString &out);
-
-    // IP 解析：优先 netsh（定向接口），兜底 ipconfig（也尽量按接口段落取）
-    static bool parseIpByNetsh(const QString &iface, WifiInfo &io);
-    static bool parseIpByIpconfig(const QString &iface, WifiInfo &io);
+    static bool looksLikeDisconnectOutput(const QString &out);
+    static bool connectConfirmed(const WifiInfo &cur, const QString &targetSsid);
+
+    static QString connectCommand(const QString &profileName, const QString &ssid, const QString &interfaceName);
+    static QString disconnectCommand(const QString &interfaceName);
+
+    // IP 探测：netsh ipv4 / netsh ip（定向接口）和 ipconfig（按接口段落取）三条命令互不依赖，
+    // 同时跑，先解析出结果的那条为准
+    enum IpProbe { ProbeNetshIpv4, ProbeNetshIp, ProbeIpconfig };
+    static QString ipProbeCommand(IpProbe probe, const QString &iface);
+    static bool parseIpProbe(IpProbe probe, const QString &output, const QString &iface, WifiInfo &io);
+
+    // 同时跑的一组命令（定义在 cpp 里）
+    class CmdRace;
+    // ipconfigIdx：race 里已经在跑的 ipconfig（-1 = 没有）；ipconfigOut：已经跑完的 ipconfig 输出
+    static bool raceIpProbes(CmdRace &race, const QString &iface, WifiInfo &io,
+                             int ipconfigIdx = -1, const QString *ipconfigOut = nullptr);
 };
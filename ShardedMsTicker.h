@@ -0,0 +1,195 @@
+#pragma once
+#include <QObject>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "MultiMsTicker.h"
+
+// 分片版 MultiMsTicker：timer id 按哈希分到 N 个分片，每个分片是一个独立的 MultiMsTicker
+// （Thread 后端，自己的调度线程、堆和时钟），单线程扫不过来的 10 万级 timer 分摊到多个核上
+// 接口和 MultiMsTicker 一致；timeout 等信号从各分片的调度线程发出（连到别的线程的对象时自动 queued）
+// 统计接口返回所有分片的汇总
+class ShardedMsTicker final : public QObject {
+    Q_OBJECT
+public:
+    using Backend = TickerBackend;
+    using CatchUp = TickerCatchUp;
+    using Overlap = TickerOverlap;
+    using TimerConfig = MultiMsTicker::TimerConfig;
+    using GlobalConfig = MultiMsTicker::GlobalConfig;
+    using TimeoutCallback = MultiMsTicker::TimeoutCallback;
+    using DispatchStats = MultiMsTicker::DispatchStats;
+    using CoalesceStats = MultiMsTicker::CoalesceStats;
+
+    // shards <= 0：按 CPU 核数
+    explicit ShardedMsTicker(int shards = 0, QObject* parent = nullptr)
+        : QObject(parent)
+    {
+        if (shards <= 0) shards = qMax(1, QThread::idealThreadCount());
+        GlobalConfig g;
+        g.backend = Backend::Thread;
+        m_shards.reserve(size_t(shards));
+        for (int i = 0; i < shards; ++i) {
+            std::unique_ptr<MultiMsTicker> shard(new MultiMsTicker);
+            shard->setGlobalConfig(g);
+            // 信号转发一律直连：从分片的调度线程原样发出去，连到别的线程的对象时再由外面那一跳排队；
+            // 默认的 AutoConnection 会因为本对象在主线程而先排一次队，多一跳延迟，主线程忙时还会积压
+            connect(shard.get(), &MultiMsTicker::wake, this, &ShardedMsTicker::wake, Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::timerStarted, this, &ShardedMsTicker::timerStarted,
+                    Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::timerStopped, this, &ShardedMsTicker::timerStopped,
+                    Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::timerRemoved, this, &ShardedMsTicker::timerRemoved,
+                    Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::timeout, this, &ShardedMsTicker::timeout, Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::ticksMissed, this, &ShardedMsTicker::ticksMissed,
+                    Qt::DirectConnection);
+            connect(shard.get(), &MultiMsTicker::timeoutBatch, this, &ShardedMsTicker::timeoutBatch,
+                    Qt::DirectConnection);
+            // 分片自动停下（所有 timer 都停了）时，全部分片都停了才算整体停止
+            connect(shard.get(), &MultiMsTicker::stopped, this, &ShardedMsTicker::onShardStopped,
+                    Qt::DirectConnection);
+            m_shards.push_back(std::move(shard));
+        }
+    }
+
+    int shardCount() const { return int(m_shards.size()); }
+
+    // 该 id 落在哪个分片（Fibonacci 哈希，连续 id 也能均匀分开）
+    // 取乘积的高位映射到 [0, shards)：低位混合得差，直接取模在分片数为 2 的幂时等于只看 id 的低几位
+    int shardOf(int id) const {
+        return int((quint64(quint32(id) * 0x9E3779B1u) * quint64(m_shards.size())) >> 32);
+    }
+
+    // 各分片的调度线程上调用，startAll 之前设置
+    void setTimeoutCallback(TimeoutCallback fn) {
+        for (auto& shard : m_shards) shard->setTimeoutCallback(fn);
+    }
+
+    // ---------- 默认参数 ----------
+    void setDefaultTimerConfig(const TimerConfig& cfg) {
+        for (auto& shard : m_shards) shard->setDefaultTimerConfig(cfg);
+    }
+    TimerConfig defaultTimerConfig() const {
+        return m_shards.front()->defaultTimerConfig();
+    }
+
+    // backend 固定为 Thread（分片的意义就在于各自的调度线程），其余原样下发到每个分片
+    void setGlobalConfig(const GlobalConfig& cfg) {
+        GlobalConfig g = cfg;
+        g.backend = Backend::Thread;
+        for (auto& shard : m_shards) shard->setGlobalConfig(g);
+    }
+    GlobalConfig globalConfig() const {
+        return m_shards.front()->globalConfig();
+    }
+
+    // ---------- 管理定时器 ----------
+    void setTimerConfig(int id, const TimerConfig& cfg) { shard(id).setTimerConfig(id, cfg); }
+    void setIntervalMs(int id, int intervalMs) { shard(id).setIntervalMs(id, intervalMs); }
+    void setIntervalNs(int id, qint64 intervalNs) { shard(id).setIntervalNs(id, intervalNs); }
+    TimerConfig timerConfig(int id) const { return shard(id).timerConfig(id); }
+
+    void startTimer(int id) {
+        m_running.store(true);
+        shard(id).startTimer(id);
+    }
+    void stopTimer(int id) { shard(id).stopTimer(id); }
+    void removeTimer(int id) { shard(id).removeTimer(id); }
+    bool hasTimer(int id) const { return shard(id).hasTimer(id); }
+    void resetTimer(int id) { shard(id).resetTimer(id); }
+
+    // ---------- 全局启动/停止 ----------
+    bool isRunning() const {
+        for (auto& shard : m_shards) {
+            if (shard->isRunning()) return true;
+        }
+        return false;
+    }
+
+    // ---------- 统计（所有分片汇总） ----------
+    TickerStats::Snapshot timerStats(int id, bool reset = false) {
+        return shard(id).timerStats(id, reset);
+    }
+
+    TickerStats::Snapshot latenessStats(bool reset = false) {
+        std::unique_ptr<TickerStats> sum(new TickerStats);
+        for (auto& shard : m_shards) shard->mergeLatenessStats(*sum, reset);
+        return sum->snapshot();
+    }
+
+    TickerStats::Snapshot wakeupStats(bool reset = false) {
+        std::unique_ptr<TickerStats> sum(new TickerStats);
+        for (auto& shard : m_shards) shard->mergeWakeupStats(*sum, reset);
+        return sum->snapshot();
+    }
+
+    DispatchStats dispatchStats(bool reset = false) {
+        DispatchStats sum;
+        for (auto& shard : m_shards) {
+            const DispatchStats s = shard->dispatchStats(reset);
+            sum.dispatched += s.dispatched;
+            sum.overlapped += s.overlapped;
+            sum.skipped += s.skipped;
+        }
+        return sum;
+    }
+
+    CoalesceStats coalesceStats(bool reset = false) {
+        CoalesceStats sum;
+        for (auto& shard : m_shards) {
+            const CoalesceStats s = shard->coalesceStats(reset);
+            sum.wakeups += s.wakeups;
+            sum.savedWakeups += s.savedWakeups;
+        }
+        return sum;
+    }
+
+    // 所有分片的调度线程都拿到了 SCHED_FIFO
+    bool isRealtime() const {
+        for (auto& shard : m_shards) {
+            if (!shard->isRealtime()) return false;
+        }
+        return true;
+    }
+
+public slots:
+    void startAll() {
+        m_running.store(true);
+        for (auto& shard : m_shards) shard->startAll();
+        emit started();
+    }
+
+    void stopAll() {
+        // 各分片的 stopped 经 onShardStopped 汇总成一次
+        for (auto& shard : m_shards) shard->stopAll();
+    }
+
+signals:
+    void started();
+    void stopped();
+    void wake(int deltaMs);
+
+    void timerStarted(int id);
+    void timerStopped(int id);
+    void timerRemoved(int id);
+
+    void timeout(int id, int deltaMs);
+    void ticksMissed(int id, int missed);
+    void timeoutBatch(const QVector<TickerTimeoutRecord>& records);
+
+private slots:
+    void onShardStopped() {
+        if (isRunning()) return;
+        if (m_running.exchange(false)) emit stopped();
+    }
+
+private:
+    MultiMsTicker& shard(int id) const {
+        return *m_shards[size_t(shardOf(id))];
+    }
+
+    std::vector<std::unique_ptr<MultiMsTicker> > m_shards;
+    std::atomic<bool> m_running{false};
+};
@@ -2,16 +2,59 @@
 #include <QObject>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QMutex>
+#include <QThread>
+#include <memory>
+#include <functional>
+#include <climits>
+#include <atomic>
+#include "TickerThread.h"
+#include "TickerStats.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
 
 class SimpleMsTicker final : public QObject {
     Q_OBJECT
 public:
+    using Backend = TickerBackend;
+    using CatchUp = TickerCatchUp;
+
     struct Config {
         int intervalMs = 10;   // 逻辑周期：到点就触发 timeout()
         int wakeupMs   = 1;    // 唤醒周期：内部轮询频率（1~2ms 常用）
         bool emitWake  = false; // 是否每次唤醒都发 wake(deltaMs)
+        bool adaptiveWakeup = false; // 自适应唤醒：不按 wakeupMs 轮询，单次定时器直接睡到下次到点
+        // Thread：在独立调度线程上按绝对到点时刻（ns）触发，忽略 wakeupMs/adaptiveWakeup；
+        // timeout 等信号从调度线程发出，连到其他线程的对象时自动走 queued 连接
+        Backend backend = Backend::EventLoop;
+        int threadPriority = 0; // Thread 后端：>0 为 SCHED_FIFO 优先级（1~99），需要权限
+        qint64 intervalNs = 0;  // >0 时按 ns 周期，覆盖 intervalMs（250µs 控制节拍 = 250000）
+        // 锁相：到点时刻从 start() 起按周期整倍数推进，唤醒晚了不累积漂移
+        // 不锁相（默认）：下一次 = 实际触发时刻 + 周期
+        bool phaseLocked = false;
+        CatchUp catchUp = CatchUp::Skip; // 锁相模式下错过整周期时的处理
+        bool collectStats = false; // 统计触发延迟直方图、超时/错过计数，以及每次唤醒的耗时
+        // 先睡后转（仅 Thread 后端）：睡到到点前一小段余量，再忙等单调时钟到点，抖动到 µs 级
+        // 余量按实测的睡眠唤醒误差自动调整；忙等占 CPU 超过预算就退回纯睡眠，下一个统计窗口再试
+        bool spinWait = false;
+        int spinMarginUs = 0;        // 余量初值（µs），0=200µs；之后自动调整
+        int spinBudgetPercent = 20;  // 忙等最多占一个核的百分比（每秒统计一次）
     };
 
+    // 先睡后转的当前状态
+    struct SpinInfo {
+        qint64 marginNs = 0;     // 当前余量
+        quint64 spinNs = 0;      // 累计忙等时间
+        quint64 fallbacks = 0;   // 因超预算退回纯睡眠的次数
+        bool sleepingOnly = false; // 当前窗口是否已退回纯睡眠
+    };
+
+    // 到点回调：直接在触发线程上调用（Thread 后端即调度线程），先于 timeout 信号；start 之前设置
+    // missed = 本次合并掉的周期数（仅锁相 + Coalesce 时非 0）
+    using TimeoutCallback = std::function<void(int deltaMs, int missed)>;
+
     explicit SimpleMsTicker(QObject* parent = nullptr)
         : QObject(parent)
     {
@@ -20,30 +63,99 @@ public:
         connect(&m_timer, &QTimer::timeout, this, &SimpleMsTicker::onWakeup);
     }
 
+    ~SimpleMsTicker() override {
+        if (m_thread) m_thread->stopAndWait();
+    }
+
+    void setTimeoutCallback(TimeoutCallback fn) {
+        QMutexLocker lock(&m_mutex);
+        m_callback = std::move(fn);
+    }
+
     void setConfig(const Config& cfg) {
+        QMutexLocker lock(&m_mutex);
+        const Config old = m_cfg;
         m_cfg = cfg;
         if (m_cfg.intervalMs < 1) m_cfg.intervalMs = 1;
         if (m_cfg.wakeupMs   < 1) m_cfg.wakeupMs   = 1;
+        if (m_cfg.intervalNs < 0) m_cfg.intervalNs = 0;
+        if (m_cfg.intervalNs > 0 && m_cfg.intervalNs < kMinIntervalNs) m_cfg.intervalNs = kMinIntervalNs;
+        m_cfg.spinMarginUs = qBound(0, m_cfg.spinMarginUs, int(kMaxSpinMarginNs / 1000));
+        m_cfg.spinBudgetPercent = qBound(0, m_cfg.spinBudgetPercent, 100);
+        if (m_cfg.spinMarginUs != old.spinMarginUs || (m_cfg.spinWait && !old.spinWait)) {
+            m_spinMarginNs.store(m_cfg.spinMarginUs > 0 ? m_cfg.spinMarginUs * 1000LL : kDefaultSpinMarginNs);
+        }
+        // 运行中打开锁相：以上一次触发为起点
+        if (m_cfg.phaseLocked && !old.phaseLocked) m_gridNs = m_lastFireNs;
+
+        // 运行中：自适应模式 / 调度线程按新周期重新定时；切换模式、后端也立即生效
+        if (m_running && (m_cfg.adaptiveWakeup || old.adaptiveWakeup
+                          || m_cfg.backend != old.backend || m_cfg.backend == Backend::Thread)) {
+            arm();
+        }
     }
 
-    Config config() const { return m_cfg; }
-    bool isRunning() const { return m_timer.isActive(); }
+    Config config() const {
+        QMutexLocker lock(&m_mutex);
+        return m_cfg;
+    }
+    bool isRunning() const {
+        QMutexLocker lock(&m_mutex);
+        return m_running;
+    }
+
+    // ---------- 统计（collectStats 打开后才记录；不用停 ticker，任意线程随时取） ----------
+    // 触发延迟（实际触发 - 理论到点，ns）分位数、处理超时次数、错过周期数；reset=true 取完清零
+    TickerStats::Snapshot stats(bool reset = false) {
+        return m_stats.snapshot(reset);
+    }
+
+    // 每次唤醒本身的耗时（不含槽函数/回调）
+    TickerStats::Snapshot wakeupStats(bool reset = false) {
+        return m_wakeStats.snapshot(reset);
+    }
+
+    SpinInfo spinInfo() const {
+        SpinInfo info;
+        info.marginNs = m_spinMarginNs.load(std::memory_order_relaxed);
+        info.spinNs = m_spinTotalNs.load(std::memory_order_relaxed);
+        info.fallbacks = m_spinFallbacks.load(std::memory_order_relaxed);
+        info.sleepingOnly = m_spinSleepOnly.load(std::memory_order_relaxed);
+        return info;
+    }
+
+    // Thread 后端下调度线程是否拿到了 SCHED_FIFO
+    bool isRealtime() const {
+        QMutexLocker lock(&m_mutex);
+        return m_thread && m_thread->isRealtime();
+    }
 
 public slots:
     void start() {
-        if (m_timer.isActive()) return;
+        {
+            QMutexLocker lock(&m_mutex);
+            if (m_running) return;
 
-        m_elapsed.restart();
-        m_lastWakeNs = m_elapsed.nsecsElapsed();
-        m_lastFireNs = m_lastWakeNs;
+            m_elapsed.restart();
+            m_lastWakeNs = m_elapsed.nsecsElapsed();
+            m_lastFireNs = m_lastWakeNs;
+            m_gridNs = m_lastWakeNs;
+            m_spinDueNs = -1;
 
-        m_timer.start(m_cfg.wakeupMs);
+            m_running = true;
+            arm();
+        }
         emit started();
     }
 
     void stop() {
-        if (!m_timer.isActive()) return;
-        m_timer.stop();
+        {
+            QMutexLocker lock(&m_mutex);
+            if (!m_running) return;
+            m_running = false;
+            // Thread 后端：调度线程不退出，tick 返回 -1 后一直睡着
+            syncTimer();
+        }
         emit stopped();
     }
 
@@ -57,11 +169,25 @@ signals:
     // 到点触发：deltaMs=距上次 timeout 的真实间隔（用于你观察抖动/漂移）
     void timeout(int deltaMs);
 
+    // 锁相 + Coalesce：这次 timeout 合并掉了 missed 个周期（紧接着发 timeout）
+    void ticksMissed(int missed);
+
 private slots:
     void onWakeup() {
-        if (!m_elapsed.isValid()) return;
+        processWakeup();
+    }
 
-        const qint64 nowNs = m_elapsed.nsecsElapsed();
+private:
+    // 处理一次唤醒：两种后端共用；发信号前先解锁，槽函数/回调里可以直接调 stop()/setConfig()
+    void processWakeup() {
+        QMutexLocker lock(&m_mutex);
+        if (!m_running || !m_elapsed.isValid()) return;
+
+        // 时钟快照：解锁期间别的线程 stop()+start() 会 restart m_elapsed，这里只读副本
+        const QElapsedTimer clock = m_elapsed;
+        const qint64 nowNs = clock.nsecsElapsed();
+        const bool collect = m_cfg.collectStats;
+        qint64 handlerNs = 0; // 槽函数/回调耗时，从唤醒耗时里扣掉
 
         // 1) 计算距上次“唤醒”的真实间隔
         int wakeDeltaMs = int((nowNs - m_lastWakeNs) / 1000000);
@@ -69,27 +195,239 @@ private slots:
         m_lastWakeNs = nowNs;
 
         if (m_cfg.emitWake) {
+            lock.unlock();
             emit wake(wakeDeltaMs);
+            lock.relock();
+            if (collect) handlerNs += clock.nsecsElapsed() - nowNs;
         }
 
         // 2) 计算距上次“到点触发”的经过时间
         const qint64 sinceFireNs = nowNs - m_lastFireNs;
-        if (sinceFireNs < 0) return;
 
-        // 3) 到点就触发一次 timeout（不补帧）
-        if (sinceFireNs >= qint64(m_cfg.intervalMs) * 1000000LL) {
-            const int fireDeltaMs = int(sinceFireNs / 1000000);
+        // 3) 到点就触发一次 timeout（不锁相时不补帧；锁相 + Burst 时逐个补到追上为止）
+        while (m_running && sinceFireNs >= 0 && nowNs >= nextDueNs()) {
+            const int fireDeltaMs = int((nowNs - m_lastFireNs) / 1000000);
+            const qint64 period = periodNs();
+            if (collect) {
+                const qint64 lateNs = nowNs - nextDueNs();
+                m_stats.record(lateNs);
+                if (!(m_cfg.phaseLocked && m_cfg.catchUp == CatchUp::Burst)) {
+                    m_stats.addMissed(quint64(lateNs / period));
+                }
+            }
+            const int missed = advancePhase(nowNs);
             m_lastFireNs = nowNs;
+
+            const qint64 t0 = collect ? clock.nsecsElapsed() : 0;
+            lock.unlock();
+            if (m_callback) m_callback(fireDeltaMs, missed);
+            if (missed > 0) emit ticksMissed(missed);
             emit timeout(fireDeltaMs);
+            if (collect) {
+                const qint64 spentNs = clock.nsecsElapsed() - t0;
+                handlerNs += spentNs;
+                if (spentNs > period) m_stats.addOverrun();
+            }
+            lock.relock();
+            if (!m_cfg.phaseLocked || m_cfg.catchUp != CatchUp::Burst) break;
+        }
+
+        if (collect) {
+            m_wakeStats.record(clock.nsecsElapsed() - nowNs - handlerNs);
+        }
+
+        // 4) 自适应模式：重新定到下一次到点（槽函数里可能已经 stop）
+        if (m_running && m_cfg.backend == Backend::EventLoop && m_cfg.adaptiveWakeup) {
+            arm();
         }
     }
 
-private:
+    // 调度线程上执行：返回距下一次到点的 ns（<0 = 已停止，睡到被唤醒）
+    qint64 threadTick() {
+        qint64 spinDueNs = -1;
+        qint64 sleepTargetNs = -1;
+        QElapsedTimer clock;
+        {
+            // 运行中切回 EventLoop 后，调度线程不再处理
+            QMutexLocker lock(&m_mutex);
+            spinDueNs = m_spinDueNs;
+            sleepTargetNs = m_spinSleepTargetNs;
+            m_spinDueNs = -1;
+            if (!m_running || m_cfg.backend != Backend::Thread) return -1;
+            clock = m_elapsed;
+        }
+        // 先睡后转：上一次只睡到余量之前，这里忙等到点（不拿锁，只读时钟快照）
+        if (spinDueNs > 0) spinUntil(clock, spinDueNs, sleepTargetNs);
+        processWakeup();
+
+        QMutexLocker lock(&m_mutex);
+        if (!m_running || m_cfg.backend != Backend::Thread) return -1;
+        const qint64 dueNs = nextDueNs();
+        const qint64 nowNs = m_elapsed.nsecsElapsed();
+        const qint64 remainNs = dueNs - nowNs;
+        if (remainNs <= 0) return 0;
+        if (!m_cfg.spinWait || !spinAllowed(nowNs)) return remainNs;
+
+        const qint64 marginNs = m_spinMarginNs.load(std::memory_order_relaxed);
+        m_spinDueNs = dueNs;
+        if (remainNs <= marginNs) {
+            m_spinSleepTargetNs = -1;  // 已经在余量以内：不睡，马上回来转
+            return 0;
+        }
+        m_spinSleepTargetNs = dueNs - marginNs;
+        return remainNs - marginNs;
+    }
+
+    // 调度线程上执行，不持锁：忙等到 dueNs，并用这次的睡眠唤醒误差调整余量
+    // clock 是持锁时取的 m_elapsed 副本，start() 在这期间 restart 也不影响（dueNs 就是按它算的）
+    void spinUntil(const QElapsedTimer& clock, qint64 dueNs, qint64 sleepTargetNs) {
+        const qint64 wokeNs = clock.nsecsElapsed();
+        if (sleepTargetNs > 0) {
+            // 被 setConfig/start 提前叫醒：不转，回去按新的到点重新算
+            if (wokeNs < sleepTargetNs) return;
+            tuneSpinMargin(wokeNs - sleepTargetNs);
+        }
+        if (wokeNs >= dueNs) return;
+        qint64 nowNs = wokeNs;
+        while (nowNs < dueNs) {
+            cpuRelax();
+            nowNs = clock.nsecsElapsed();
+        }
+        const qint64 spentNs = nowNs - wokeNs;
+        m_spinWindowNs += spentNs;
+        m_spinTotalNs.fetch_add(quint64(spentNs), std::memory_order_relaxed);
+    }
+
+    // 快升慢降地追踪误差的 1.5 倍：比余量大时每次补 1/4 差距，小时每次收 1/64
+    // 稳定在唤醒误差的高分位附近，偶尔一次调度抖动不会把余量（也就是忙等时间）一下子拉满
+    void tuneSpinMargin(qint64 errNs) {
+        const qint64 wantNs = qBound(kMinSpinMarginNs, errNs + errNs / 2, kMaxSpinMarginNs);
+        const qint64 marginNs = m_spinMarginNs.load(std::memory_order_relaxed);
+        const qint64 stepNs = wantNs > marginNs ? (wantNs - marginNs) / 4 : (wantNs - marginNs) / 64;
+        m_spinMarginNs.store(marginNs + stepNs, std::memory_order_relaxed);
+    }
+
+    // CPU 预算：按 1s 窗口统计忙等时间，超了本窗口剩下的时间只睡不转
+    // 要求已持有 m_mutex（读 m_cfg）
+    bool spinAllowed(qint64 nowNs) {
+        if (nowNs - m_spinWindowStartNs >= kSpinWindowNs || nowNs < m_spinWindowStartNs) {
+            m_spinWindowStartNs = nowNs;
+            m_spinWindowNs = 0;
+            m_spinSleepOnly.store(false, std::memory_order_relaxed);
+        }
+        if (m_spinSleepOnly.load(std::memory_order_relaxed)) return false;
+        if (m_spinWindowNs * 100 > kSpinWindowNs * m_cfg.spinBudgetPercent) {
+            m_spinSleepOnly.store(true, std::memory_order_relaxed);
+            m_spinFallbacks.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    static void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+        __asm__ __volatile__("yield");
+#endif
+    }
+
+    // 以下要求已持有 m_mutex
+    qint64 periodNs() const {
+        return m_cfg.intervalNs > 0 ? m_cfg.intervalNs : qint64(m_cfg.intervalMs) * 1000000LL;
+    }
+
+    qint64 nextDueNs() const {
+        return (m_cfg.phaseLocked ? m_gridNs : m_lastFireNs) + periodNs();
+    }
+
+    // 锁相模式下把节拍点推进到下一个未来时刻，返回要报告的错过周期数
+    // Skip/Coalesce：一次跳过所有已错过的节拍（Coalesce 报告个数）；Burst：只推进一拍
+    int advancePhase(qint64 nowNs) {
+        if (!m_cfg.phaseLocked) return 0;
+        const qint64 period = periodNs();
+        if (m_cfg.catchUp == CatchUp::Burst) {
+            m_gridNs += period;
+            return 0;
+        }
+        const qint64 ticks = (nowNs - m_gridNs) / period; // >=1：已到点
+        m_gridNs += ticks * period;
+        if (m_cfg.catchUp != CatchUp::Coalesce || ticks <= 1) return 0;
+        return int(qMin<qint64>(ticks - 1, INT_MAX));
+    }
+
+    // 固定模式：按 wakeupMs 周期轮询；自适应模式：单次定时器，向上取整到 ms，宁晚勿早
+    // Thread 后端：叫醒调度线程按新的到点时刻重新睡
+    void arm() {
+        if (m_cfg.backend == Backend::Thread) {
+            if (!m_thread) {
+                m_thread.reset(new TickerThread([this] { return threadTick(); }));
+                m_thread->setObjectName(QStringLiteral("SimpleMsTicker"));
+            }
+            m_thread->setRealtimePriority(m_cfg.threadPriority);
+            if (!m_thread->isRunning()) m_thread->start();
+            m_thread->wakeUp();
+        }
+        syncTimer();
+    }
+
+    // QTimer 只能在所属线程上启停：别的线程上（如 Thread 后端回调里 setConfig 切回 EventLoop）
+    // 投递到所属线程，到时候按那一刻的状态再定，不带走这里的参数
+    void syncTimer() {
+        if (QThread::currentThread() == thread()) {
+            syncTimerLocked();
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this] {
+            QMutexLocker lock(&m_mutex);
+            syncTimerLocked();
+        }, Qt::QueuedConnection);
+    }
+
+    // 所属线程上、持有 m_mutex：按当前状态启停 m_timer
+    void syncTimerLocked() {
+        if (!m_running || m_cfg.backend == Backend::Thread) {
+            m_timer.stop();
+            return;
+        }
+        m_timer.setSingleShot(m_cfg.adaptiveWakeup);
+        if (!m_cfg.adaptiveWakeup) {
+            m_timer.start(m_cfg.wakeupMs);
+            return;
+        }
+        const qint64 remainNs = nextDueNs() - m_elapsed.nsecsElapsed();
+        m_timer.start(remainNs > 0 ? int((remainNs + 999999) / 1000000) : 0);
+    }
+
     Config m_cfg;
+    bool m_running = false;
 
     QTimer m_timer;
     QElapsedTimer m_elapsed;
 
     qint64 m_lastWakeNs = 0;
     qint64 m_lastFireNs = 0;
+    qint64 m_gridNs = 0;      // 锁相模式：上一个节拍点（start 时刻 + k*周期）
+
+    mutable QMutex  m_mutex;   // 保护以上状态（Thread 后端下调度线程与调用方并发访问）
+    TimeoutCallback m_callback;
+    std::unique_ptr<TickerThread> m_thread;
+    TickerStats m_stats;       // 触发延迟
+    TickerStats m_wakeStats;   // 唤醒耗时
+
+    // 先睡后转（m_spinDueNs/m_spinSleepTargetNs 由 m_mutex 保护，其余只在调度线程上改）
+    qint64 m_spinDueNs = -1;          // 下一次 tick 要忙等到的时刻
+    qint64 m_spinSleepTargetNs = -1;  // 这次睡眠的目标唤醒时刻（算唤醒误差）
+    qint64 m_spinWindowStartNs = 0;
+    qint64 m_spinWindowNs = 0;        // 本窗口已忙等的时间
+    std::atomic<qint64>  m_spinMarginNs{kDefaultSpinMarginNs};
+    std::atomic<quint64> m_spinTotalNs{0};
+    std::atomic<quint64> m_spinFallbacks{0};
+    std::atomic<bool>    m_spinSleepOnly{false};
+
+    static constexpr qint64 kMinIntervalNs = 1000; // ns 周期下限，防止 Burst 补发失控
+    static constexpr qint64 kDefaultSpinMarginNs = 200000;
+    static constexpr qint64 kMinSpinMarginNs = 20000;
+    static constexpr qint64 kMaxSpinMarginNs = 2000000;
+    static constexpr qint64 kSpinWindowNs = 1000000000;
 };
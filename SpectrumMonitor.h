@@ -0,0 +1,281 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
+#include "CFftAsync.h"
+#include "MultiMsTicker.h"
+#include "TickerStats.h"
+
+// 按通道周期做 FFT 的监视器：每个通道对应 MultiMsTicker 的一个 timer id
+// - pushSamples 把采样写进通道的环形缓冲（任意线程）
+// - timer 到点时调度线程只做一次 CAS 把分析任务丢进线程池，FFT 在工作线程上用缓冲里最新的 frameLen 个点算
+// - 结果从工作线程 emit spectrumReady（连到 UI 对象时自动 queued），同时留一份给 latestSpectrum 读
+// - 上一次分析还没算完又到点 -> dropped；分析耗时（从到点算起）超过周期 -> late
+class SpectrumMonitor final : public QObject {
+    Q_OBJECT
+public:
+    struct ChannelConfig {
+        int   intervalMs = 100;    // 分析周期
+        int   frameLen   = 1024;   // 每次分析的点数（<= CFftAsync::kMaxDataLen）
+        float sampleRate = 16000;  // 采样率（Hz）
+        int   bufferLen  = 0;      // 环形缓冲长度；0 = frameLen * 4
+    };
+
+    struct ChannelStats {
+        quint64 analyses = 0;      // 完成的分析次数
+        quint64 dropped  = 0;      // 到点时上一次还没算完，本次丢弃
+        quint64 starved  = 0;      // 到点时缓冲里的点数不够 frameLen，本次跳过
+        quint64 late     = 0;      // 从到点到发布超过一个周期
+        quint64 missedTicks = 0;   // 调度本身错过、合并掉的周期数（唤醒晚了整周期以上）
+    };
+
+    explicit SpectrumMonitor(QObject* parent = nullptr)
+        : QObject(parent)
+        , m_ticker(new MultiMsTicker)
+    {
+        qRegisterMetaType<FftSpectrum>("FftSpectrum");
+        m_elapsed.start();
+        MultiMsTicker::GlobalConfig g;
+        g.backend = TickerBackend::Thread;
+        g.perTimerStats = false;
+        m_ticker->setGlobalConfig(g);
+        m_ticker->setTimeoutCallback([this](int id, int, int missed, qint64 lateNs) { onTick(id, missed, lateNs); });
+    }
+
+    ~SpectrumMonitor() override {
+        // 先停掉调度线程（不会再起新任务），再等工作线程
+        m_ticker.reset();
+        while (m_tasks.load() > 0) QThread::yieldCurrentThread();
+    }
+
+    // 分析任务用的线程池（nullptr = 全局线程池），start 之前设置
+    void setThreadPool(QThreadPool* pool) { m_pool.store(pool); }
+
+    // 调度线程的全局参数（backend 固定为 Thread：分析任务不能等 UI 事件循环）
+    void setGlobalConfig(const MultiMsTicker::GlobalConfig& cfg) {
+        MultiMsTicker::GlobalConfig g = cfg;
+        g.backend = TickerBackend::Thread;
+        m_ticker->setGlobalConfig(g);
+    }
+
+    // ---------- 通道 ----------
+    // 添加或修改通道；改 frameLen / bufferLen 会清空缓冲
+    void setChannel(int id, const ChannelConfig& cfg) {
+        ChannelConfig c = cfg;
+        if (c.intervalMs < 1) c.intervalMs = 1;
+        if (c.frameLen < 1) c.frameLen = 1;
+        if (c.frameLen > CFftAsync::kMaxDataLen) c.frameLen = CFftAsync::kMaxDataLen;
+        if (c.bufferLen < c.frameLen) c.bufferLen = c.frameLen * 4;
+
+        std::shared_ptr<Channel> ch = channel(id);
+        if (!ch) {
+            ch = std::make_shared<Channel>();
+            QMutexLocker lock(&m_mutex);
+            m_channels.insert(id, ch);
+        }
+        {
+            QMutexLocker lock(&ch->mutex);
+            if (ch->ring.size() != c.bufferLen || ch->cfg.frameLen != c.frameLen) {
+                ch->ring = QVector<float>(c.bufferLen, 0.0f);
+                ch->writePos = 0;
+                ch->filled = 0;
+            }
+            ch->cfg = c;
+        }
+
+        MultiMsTicker::TimerConfig t = m_ticker->hasTimer(id) ? m_ticker->timerConfig(id) : MultiMsTicker::TimerConfig();
+        t.intervalMs = c.intervalMs;
+        t.intervalNs = 0;
+        // 锁相 + Coalesce：分析只要最新数据，错过的周期不补，但要报告个数（missedTicks）
+        t.phaseLocked = true;
+        t.catchUp = TickerCatchUp::Coalesce;
+        m_ticker->setTimerConfig(id, t);
+    }
+
+    void removeChannel(int id) {
+        m_ticker->removeTimer(id);
+        QMutexLocker lock(&m_mutex);
+        m_channels.remove(id); // 还在算的任务持有 shared_ptr，算完自然释放
+    }
+
+    bool hasChannel(int id) const { return bool(channel(id)); }
+
+    // 写入采样（任意线程；超过缓冲长度时只保留最后 bufferLen 个点）
+    void pushSamples(int id, const float* data, int count) {
+        const std::shared_ptr<Channel> ch = channel(id);
+        if (!ch || count <= 0) return;
+        QMutexLocker lock(&ch->mutex);
+        const int size = ch->ring.size();
+        if (count > size) {
+            data += count - size;
+            count = size;
+        }
+        float* ring = ch->ring.data();
+        for (int i = 0; i < count; ++i) {
+            ring[ch->writePos] = data[i];
+            if (++ch->writePos == size) ch->writePos = 0;
+        }
+        ch->filled = qMin<qint64>(ch->filled + count, size);
+    }
+
+    void pushSamples(int id, const QVector<float>& samples) {
+        pushSamples(id, samples.constData(), samples.size());
+    }
+
+    // 最近一次发布的频谱（还没有时 seq == 0）
+    FftSpectrum latestSpectrum(int id) const {
+        const std::shared_ptr<Channel> ch = channel(id);
+        if (!ch) return FftSpectrum();
+        QMutexLocker lock(&ch->mutex);
+        return ch->latest;
+    }
+
+    // ---------- 启动/停止 ----------
+    void startChannel(int id) { m_ticker->startTimer(id); }
+    void stopChannel(int id) { m_ticker->stopTimer(id); }
+    void start() { m_ticker->startAll(); }
+    void stop() { m_ticker->stopAll(); }
+    bool isRunning() const { return m_ticker->isRunning(); }
+
+    // ---------- 统计 ----------
+    ChannelStats channelStats(int id, bool reset = false) const {
+        ChannelStats s;
+        const std::shared_ptr<Channel> ch = channel(id);
+        if (!ch) return s;
+        s.analyses = take(ch->analyses, reset);
+        s.dropped = take(ch->dropped, reset);
+        s.starved = take(ch->starved, reset);
+        s.late = take(ch->late, reset);
+        s.missedTicks = take(ch->missedTicks, reset);
+        return s;
+    }
+
+    // 所有通道合计：到点 -> 发布的耗时分布；overruns = late 次数，missedTicks = 调度错过的周期
+    TickerStats::Snapshot latencyStats(bool reset = false) { return m_latency.snapshot(reset); }
+    quint64 droppedCount() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // 调度线程本身的唤醒耗时 / 触发延迟
+    TickerStats::Snapshot schedulerLatenessStats(bool reset = false) { return m_ticker->latenessStats(reset); }
+
+signals:
+    // 工作线程上发出
+    void spectrumReady(int id, const FftSpectrum& spectrum);
+    void analysisDropped(int id);
+
+private:
+    struct Channel {
+        mutable QMutex mutex;     // ring / writePos / filled / cfg / latest
+        ChannelConfig cfg;
+        QVector<float> ring;
+        int writePos = 0;
+        qint64 filled = 0;
+        FftSpectrum latest;
+
+        std::atomic<bool> busy{false}; // 有分析任务在算（一个通道同时最多一个）
+        std::unique_ptr<CFftAlg> fft;  // 只在持有 busy 的任务里用（~24KB，第一次分析时分配）
+        quint64 seq = 0;               // 同上
+
+        std::atomic<quint64> analyses{0};
+        std::atomic<quint64> dropped{0};
+        std::atomic<quint64> starved{0};
+        std::atomic<quint64> late{0};
+        std::atomic<quint64> missedTicks{0};
+    };
+
+    static quint64 take(std::atomic<quint64>& v, bool reset) {
+        return reset ? v.exchange(0, std::memory_order_relaxed) : v.load(std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<Channel> channel(int id) const {
+        QMutexLocker lock(&m_mutex);
+        return m_channels.value(id);
+    }
+
+    // 调度线程：不拷数据、不算 FFT，只决定丢弃还是起任务
+    // lateNs：调度晚了多少；耗时从节拍时刻算起，唤醒晚了的部分也算进去
+    void onTick(int id, int missed, qint64 lateNs) {
+        const std::shared_ptr<Channel> ch = channel(id);
+        if (!ch) return;
+        if (missed > 0) {
+            ch->missedTicks.fetch_add(quint64(missed), std::memory_order_relaxed);
+            m_latency.addMissed(quint64(missed));
+        }
+        bool idle = false;
+        if (!ch->busy.compare_exchange_strong(idle, true, std::memory_order_acq_rel)) {
+            ch->dropped.fetch_add(1, std::memory_order_relaxed);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            emit analysisDropped(id);
+            return;
+        }
+
+        const qint64 dueNs = m_elapsed.nsecsElapsed() - lateNs;
+        QThreadPool* pool = m_pool.load();
+        if (!pool) pool = QThreadPool::globalInstance();
+        m_tasks.fetch_add(1);
+        pool->start([this, ch, id, dueNs] {
+            analyze(id, *ch, dueNs);
+            ch->busy.store(false, std::memory_order_release);
+            m_tasks.fetch_sub(1);
+        });
+    }
+
+    // 工作线程：取最新 frameLen 个点 -> FFT -> 发布
+    void analyze(int id, Channel& ch, qint64 dueNs) {
+        QVector<float> frame;
+        float sampleRate = 0;
+        qint64 periodNs = 0;
+        {
+            QMutexLocker lock(&ch.mutex);
+            const int n = ch.cfg.frameLen;
+            if (ch.filled < n) {
+                ch.starved.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            frame = QVector<float>(n);
+            const int size = ch.ring.size();
+            int pos = ch.writePos - n;
+            if (pos < 0) pos += size;
+            for (int i = 0; i < n; ++i) {
+                frame[i] = ch.ring[pos];
+                if (++pos == size) pos = 0;
+            }
+            sampleRate = ch.cfg.sampleRate;
+            periodNs = qint64(ch.cfg.intervalMs) * 1000000;
+        }
+
+        // 实例复用：freqMax 由 compute 按本帧幅度找，不受之前的帧影响
+        if (!ch.fft) ch.fft.reset(new CFftAlg);
+        const FftSpectrum s = CFftAsync::compute(*ch.fft, frame.constData(), frame.size(), sampleRate, ++ch.seq);
+        {
+            QMutexLocker lock(&ch.mutex);
+            ch.latest = s;
+        }
+        ch.analyses.fetch_add(1, std::memory_order_relaxed);
+
+        const qint64 latencyNs = m_elapsed.nsecsElapsed() - dueNs;
+        m_latency.record(latencyNs);
+        if (latencyNs > periodNs) {
+            ch.late.fetch_add(1, std::memory_order_relaxed);
+            m_latency.addOverrun();
+        }
+        emit spectrumReady(id, s);
+    }
+
+private:
+    std::unique_ptr<MultiMsTicker> m_ticker;
+    QElapsedTimer m_elapsed;
+
+    mutable QMutex m_mutex; // m_channels
+    QHash<int, std::shared_ptr<Channel> > m_channels;
+
+    std::atomic<QThreadPool*> m_pool{nullptr};
+    std::atomic<int> m_tasks{0};
+    std::atomic<quint64> m_dropped{0};
+    TickerStats m_latency;
+};
@@ -0,0 +1,250 @@
+// SimpleMsTicker / MultiMsTicker 扩展性基准（无界面，QCoreApplication）
+//
+// 扫描 timer 数量（1 ~ 100k）和唤醒周期（1 ~ 10ms），每个组合跑一段时间，输出一行 JSON：
+//   CPU/唤醒、触发延迟分位数、错过周期数、处理超时数、每个 timer 的内存
+// 每行都带上本次的参数，改了调度器之后直接拿两次的输出按 ticker+timers+wakeupMs 对比
+//
+// 用法：TickerBench [--seconds S] [--max-timers N] [--backend eventloop|thread] [--adaptive]
+//                   [--slack MS] [--align] [--simple-only] [--multi-only]
+// --slack 只在 --adaptive 或 --backend thread 下生效（EventLoop 轮询不按截止时刻安排唤醒）
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <cstdio>
+#include "BenchUtil.h"
+#include "SimpleMsTicker.h"
+#include "MultiMsTicker.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct BenchOptions {
+    int seconds = 2;
+    int maxTimers = 100000;
+    TickerBackend backend = TickerBackend::EventLoop;
+    bool adaptive = false;
+    int slackMs = 0;
+    bool align = false;
+    bool runSimple = true;
+    bool runMulti = true;
+};
+
+struct BenchResult {
+    QString ticker;
+    int timers = 0;
+    int wakeupMs = 0;
+    double seconds = 0.0;
+    quint64 wakeups = 0;
+    quint64 fires = 0;
+    double cpuNsPerWakeup = 0.0;  // 整个进程的 CPU 时间 / 唤醒次数（含 Qt 事件循环本身）
+    TickerStats::Snapshot wake;   // 唤醒扫描耗时
+    TickerStats::Snapshot late;   // 触发延迟
+    double bytesPerTimer = 0.0;
+    quint64 savedWakeups = 0;
+};
+
+// 进程 CPU 时间（用户 + 内核，ns）
+qint64 processCpuNs() {
+#ifdef Q_OS_WIN
+    FILETIME createTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &createTime, &exitTime, &kernelTime, &userTime)) return 0;
+    ULARGE_INTEGER k, u;
+    k.LowPart = kernelTime.dwLowDateTime;
+    k.HighPart = kernelTime.dwHighDateTime;
+    u.LowPart = userTime.dwLowDateTime;
+    u.HighPart = userTime.dwHighDateTime;
+    return qint64(k.QuadPart + u.QuadPart) * 100; // 100ns 单位
+#else
+    timespec ts;
+    if (::clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0;
+    return qint64(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+// 常驻内存（字节）；拿不到返回 0
+qint64 residentBytes() {
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+    return qint64(pmc.WorkingSetSize);
+#elif defined(Q_OS_LINUX)
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long pages = 0, resident = 0;
+    const int n = std::fscanf(f, "%ld %ld", &pages, &resident);
+    std::fclose(f);
+    if (n != 2) return 0;
+    return qint64(resident) * ::sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+// 跑事件循环 ms 毫秒（Thread 后端时主线程只是等着）
+void spin(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+QString snapshotJson(const TickerStats::Snapshot& s) {
+    return BenchJson()
+        .field("count", s.count).field("p50Ns", s.p50Ns).field("p99Ns", s.p99Ns).field("p999Ns", s.p999Ns)
+        .field("maxNs", s.maxNs).field("meanNs", s.meanNs).field("overruns", s.overruns)
+        .field("missedTicks", s.missedTicks)
+        .toString();
+}
+
+void printResult(const BenchOptions& opt, const BenchResult& r) {
+    BenchJson()
+        .field("ticker", r.ticker)
+        .field("backend", opt.backend == TickerBackend::Thread ? "thread" : "eventloop")
+        .field("adaptive", opt.adaptive)
+        .field("slackMs", opt.slackMs)
+        .field("align", opt.align)
+        .field("timers", r.timers)
+        .field("wakeupMs", r.wakeupMs)
+        .field("seconds", r.seconds, 3)
+        .field("wakeups", r.wakeups)
+        .field("fires", r.fires)
+        .field("savedWakeups", r.savedWakeups)
+        .field("cpuNsPerWakeup", r.cpuNsPerWakeup)
+        .field("bytesPerTimer", r.bytesPerTimer)
+        .raw("wakeScan", snapshotJson(r.wake))
+        .raw("lateness", snapshotJson(r.late))
+        .print();
+}
+
+// SimpleMsTicker：只有一个 timer，扫唤醒周期
+BenchResult benchSimple(const BenchOptions& opt, int wakeupMs) {
+    BenchResult r;
+    r.ticker = QStringLiteral("simple");
+    r.timers = 1;
+    r.wakeupMs = wakeupMs;
+
+    SimpleMsTicker ticker;
+    SimpleMsTicker::Config cfg;
+    cfg.intervalMs = 10;
+    cfg.wakeupMs = wakeupMs;
+    cfg.adaptiveWakeup = opt.adaptive;
+    cfg.backend = opt.backend;
+    cfg.collectStats = true;
+    ticker.setConfig(cfg);
+
+    QElapsedTimer wall;
+    const qint64 cpu0 = processCpuNs();
+    wall.start();
+    ticker.start();
+    spin(opt.seconds * 1000);
+    ticker.stop();
+    const qint64 cpuNs = processCpuNs() - cpu0;
+
+    r.seconds = wall.nsecsElapsed() / 1e9;
+    r.wake = ticker.wakeupStats();
+    r.late = ticker.stats();
+    r.wakeups = r.wake.count;
+    r.fires = r.late.count;
+    r.cpuNsPerWakeup = r.wakeups ? double(cpuNs) / double(r.wakeups) : 0.0;
+    return r;
+}
+
+// MultiMsTicker：timers 个 timer，周期在 10/20/50/100ms 里轮流取，起始相位错开
+BenchResult benchMulti(const BenchOptions& opt, int timers, int wakeupMs) {
+    static const int kIntervals[] = { 10, 20, 50, 100 };
+
+    BenchResult r;
+    r.ticker = QStringLiteral("multi");
+    r.timers = timers;
+    r.wakeupMs = wakeupMs;
+
+    const qint64 mem0 = residentBytes();
+    MultiMsTicker ticker;
+    MultiMsTicker::GlobalConfig g;
+    g.wakeupMs = wakeupMs;
+    g.adaptiveWakeup = opt.adaptive;
+    g.backend = opt.backend;
+    g.collectStats = true;
+    g.perTimerStats = false; // 10 万个直方图本身就要 500MB，这里只看合计
+    ticker.setGlobalConfig(g);
+
+    for (int id = 0; id < timers; ++id) {
+        MultiMsTicker::TimerConfig c;
+        c.intervalMs = kIntervals[id % 4];
+        c.slackMs = opt.slackMs;
+        c.alignGroup = opt.align ? 1 : 0;
+        c.enabled = false;
+        ticker.setTimerConfig(id, c);
+    }
+    // 相位错开：分 10 批、每批间隔 1ms 启动
+    for (int batch = 0; batch < 10; ++batch) {
+        for (int id = batch; id < timers; id += 10) ticker.startTimer(id);
+        spin(1);
+    }
+    // 到这里命令都已取完、timer 都已建好，还没有触发过（周期 >= 10ms）
+    r.bytesPerTimer = mem0 > 0 ? double(residentBytes() - mem0) / double(timers) : 0.0;
+    ticker.wakeupStats(true);
+    ticker.latenessStats(true);
+    ticker.coalesceStats(true);
+
+    QElapsedTimer wall;
+    const qint64 cpu0 = processCpuNs();
+    wall.start();
+    spin(opt.seconds * 1000);
+    const qint64 cpuNs = processCpuNs() - cpu0;
+    r.seconds = wall.nsecsElapsed() / 1e9;
+    r.wake = ticker.wakeupStats();
+    r.late = ticker.latenessStats();
+    r.savedWakeups = ticker.coalesceStats().savedWakeups;
+    ticker.stopAll();
+
+    r.wakeups = r.wake.count;
+    r.fires = r.late.count;
+    r.cpuNsPerWakeup = r.wakeups ? double(cpuNs) / double(r.wakeups) : 0.0;
+    return r;
+}
+
+BenchOptions parseOptions(const QStringList& argv) {
+    const BenchArgs args(argv);
+    BenchOptions opt;
+    opt.seconds = args.intValue("--seconds", opt.seconds, 1);
+    opt.maxTimers = args.intValue("--max-timers", opt.maxTimers, 1);
+    if (args.value("--backend") == QLatin1String("thread")) opt.backend = TickerBackend::Thread;
+    opt.adaptive = args.flag("--adaptive");
+    opt.slackMs = args.intValue("--slack", opt.slackMs, 0);
+    opt.align = args.flag("--align");
+    opt.runMulti = !args.flag("--simple-only");
+    opt.runSimple = !args.flag("--multi-only");
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const BenchOptions opt = parseOptions(app.arguments());
+    if (opt.slackMs > 0 && !opt.adaptive && opt.backend == TickerBackend::EventLoop)
+        std::fprintf(stderr, "--slack has no effect in EventLoop polling mode; add --adaptive or --backend thread\n");
+
+    static const int kWakeups[] = { 1, 2, 5, 10 };
+    static const int kTimers[] = { 1, 10, 100, 1000, 10000, 100000 };
+
+    if (opt.runSimple) {
+        for (int wakeupMs : kWakeups) printResult(opt, benchSimple(opt, wakeupMs));
+    }
+    if (opt.runMulti) {
+        for (int timers : kTimers) {
+            if (timers > opt.maxTimers) break;
+            for (int wakeupMs : kWakeups) printResult(opt, benchMulti(opt, timers, wakeupMs));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <atomic>
+
+// 定时器统计：对数-线性直方图（HdrHistogram 的简化版）+ 计数器，固定内存、无锁
+// 值 < 16ns 每 ns 一格；之后每个 2 的幂区间再线性分 16 格，分位数相对误差 < 1/16
+// 记录端（触发线程）只做 relaxed 原子加；snapshot 可以在任意线程随时调用，
+// reset 用逐格 exchange(0)，和并发的记录不会丢也不会重复计数
+class TickerStats final {
+public:
+    static constexpr int kSubBits = 4;
+    static constexpr int kSub     = 1 << kSubBits;
+    static constexpr int kMaxExp  = 40;   // 上限 2^40 ns（约 18 分钟），超出记到最后一格
+    static constexpr int kBuckets = (kMaxExp - kSubBits + 2) * kSub;
+
+    struct Snapshot {
+        quint64 count = 0;        // 样本数
+        qint64  p50Ns  = 0;
+        qint64  p99Ns  = 0;
+        qint64  p999Ns = 0;
+        qint64  maxNs  = 0;       // 精确值
+        double  meanNs = 0.0;
+        quint64 overruns    = 0;  // 处理耗时超过周期的次数（仅定时器统计）
+        quint64 missedTicks = 0;  // 错过的整周期数（仅定时器统计）
+    };
+
+    TickerStats() {
+        for (int i = 0; i < kBuckets; ++i) m_buckets[i].store(0, std::memory_order_relaxed);
+    }
+    TickerStats(const TickerStats&) = delete;
+    TickerStats& operator=(const TickerStats&) = delete;
+
+    void record(qint64 ns) {
+        if (ns < 0) ns = 0;
+        m_buckets[bucketOf(quint64(ns))].fetch_add(1, std::memory_order_relaxed);
+        m_sumNs.fetch_add(quint64(ns), std::memory_order_relaxed);
+        qint64 cur = m_maxNs.load(std::memory_order_relaxed);
+        while (ns > cur && !m_maxNs.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {}
+    }
+    void addOverrun() { m_overruns.fetch_add(1, std::memory_order_relaxed); }
+    void addMissed(quint64 n) { if (n) m_missed.fetch_add(n, std::memory_order_relaxed); }
+
+    Snapshot snapshot(bool reset = false) {
+        Snapshot s;
+        quint64 counts[kBuckets];
+        for (int i = 0; i < kBuckets; ++i) {
+            counts[i] = reset ? m_buckets[i].exchange(0, std::memory_order_relaxed)
+                              : m_buckets[i].load(std::memory_order_relaxed);
+            s.count += counts[i];
+        }
+        const quint64 sum = reset ? m_sumNs.exchange(0, std::memory_order_relaxed)
+                                  : m_sumNs.load(std::memory_order_relaxed);
+        s.maxNs = reset ? m_maxNs.exchange(0, std::memory_order_relaxed)
+                        : m_maxNs.load(std::memory_order_relaxed);
+        s.overruns = reset ? m_overruns.exchange(0, std::memory_order_relaxed)
+                           : m_overruns.load(std::memory_order_relaxed);
+        s.missedTicks = reset ? m_missed.exchange(0, std::memory_order_relaxed)
+                              : m_missed.load(std::memory_order_relaxed);
+        if (s.count == 0) return s;
+
+        s.meanNs = double(sum) / double(s.count);
+        s.p50Ns  = percentile(counts, s.count, 0.5);
+        s.p99Ns  = percentile(counts, s.count, 0.99);
+        s.p999Ns = percentile(counts, s.count, 0.999);
+        // 桶上沿可能超过真实最大值
+        s.p50Ns  = qMin(s.p50Ns, s.maxNs);
+        s.p99Ns  = qMin(s.p99Ns, s.maxNs);
+        s.p999Ns = qMin(s.p999Ns, s.maxNs);
+        return s;
+    }
+
+    // 累加到 dst（汇总多个分片的统计，分位数照样准）；reset=true 同时把自己清零
+    void mergeInto(TickerStats& dst, bool reset = false) {
+        for (int i = 0; i < kBuckets; ++i) {
+            const quint64 n = reset ? m_buckets[i].exchange(0, std::memory_order_relaxed)
+                                    : m_buckets[i].load(std::memory_order_relaxed);
+            if (n) dst.m_buckets[i].fetch_add(n, std::memory_order_relaxed);
+        }
+        dst.m_sumNs.fetch_add(reset ? m_sumNs.exchange(0, std::memory_order_relaxed)
+                                    : m_sumNs.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dst.m_overruns.fetch_add(reset ? m_overruns.exchange(0, std::memory_order_relaxed)
+                                       : m_overruns.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        dst.m_missed.fetch_add(reset ? m_missed.exchange(0, std::memory_order_relaxed)
+                                     : m_missed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        const qint64 mx = reset ? m_maxNs.exchange(0, std::memory_order_relaxed)
+                                : m_maxNs.load(std::memory_order_relaxed);
+        qint64 cur = dst.m_maxNs.load(std::memory_order_relaxed);
+        while (mx > cur && !dst.m_maxNs.compare_exchange_weak(cur, mx, std::memory_order_relaxed)) {}
+    }
+
+private:
+    static int bucketOf(quint64 v) {
+        if (v < quint64(kSub)) return int(v);
+        const int e = 63 - int(qCountLeadingZeroBits(v)); // >= kSubBits
+        if (e > kMaxExp) return kBuckets - 1;
+        return (e - kSubBits + 1) * kSub + int((v >> (e - kSubBits)) - kSub);
+    }
+
+    // 桶的上沿（含）
+    static qint64 upperOf(int b) {
+        if (b < kSub) return b;
+        const int e = b / kSub + kSubBits - 1;
+        const quint64 m = quint64(b % kSub + kSub);
+        return qint64(((m + 1) << (e - kSubBits)) - 1);
+    }
+
+    static qint64 percentile(const quint64* counts, quint64 total, double q) {
+        quint64 rank = quint64(q * double(total) + 0.999999);
+        if (rank < 1) rank = 1;
+        quint64 acc = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            acc += counts[i];
+            if (acc >= rank) return upperOf(i);
+        }
+        return upperOf(kBuckets - 1);
+    }
+
+    std::atomic<quint64> m_buckets[kBuckets];
+    std::atomic<quint64> m_sumNs{0};
+    std::atomic<qint64>  m_maxNs{0};
+    std::atomic<quint64> m_overruns{0};
+    std::atomic<quint64> m_missed{0};
+};
@@ -0,0 +1,199 @@
+#pragma once
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QDeadlineTimer>
+#include <atomic>
+#include <functional>
+
+#ifdef Q_OS_LINUX
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// 唤醒方式：EventLoop=所在线程事件循环里的 QTimer（默认）；Thread=独立调度线程
+enum class TickerBackend {
+    EventLoop,
+    Thread
+};
+
+// 锁相模式下错过整周期（唤醒晚了一个以上周期）时怎么办
+enum class TickerCatchUp {
+    Skip,       // 只触发一次，跳到下一个未来节拍，错过的直接丢掉
+    Coalesce,   // 同 Skip，但报告合并掉的周期数
+    Burst       // 逐个补发，直到追上当前时刻
+};
+
+// 回调放到线程池执行时，上一次还没跑完又到点了怎么办
+enum class TickerOverlap {
+    Skip,       // 丢掉这一次（记一次 skipped）
+    Queue,      // 排队，跑完上一次接着跑，同一个 timer 始终串行
+    Concurrent  // 直接再起一个，可能并发
+};
+
+// 独立调度线程：按绝对到点时刻睡眠，不受 GUI 事件循环繁忙的影响
+// Linux 用 timerfd（CLOCK_MONOTONIC + TFD_TIMER_ABSTIME）+ eventfd 打断；其他平台退回 QWaitCondition
+// tick 在本线程上执行：处理已到点的事件，返回距下一次到点的 ns；<0 表示没有待触发的，一直睡到 wakeUp()
+class TickerThread final : public QThread {
+public:
+    using TickFn = std::function<qint64()>;
+
+    explicit TickerThread(TickFn tick, QObject* parent = nullptr)
+        : QThread(parent)
+        , m_tick(std::move(tick))
+    {
+#ifdef Q_OS_LINUX
+        m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+        m_eventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+#endif
+    }
+
+    ~TickerThread() override {
+        stopAndWait();
+#ifdef Q_OS_LINUX
+        if (m_timerFd >= 0) ::close(m_timerFd);
+        if (m_eventFd >= 0) ::close(m_eventFd);
+#endif
+    }
+
+    // 0=普通优先级；1~99=SCHED_FIFO 实时优先级（需要 CAP_SYS_NICE，失败时退回 TimeCriticalPriority）
+    // 运行中修改会在下一次唤醒时生效
+    void setRealtimePriority(int prio) {
+        m_priority.store(prio);
+        wakeUp();
+    }
+    bool isRealtime() const { return m_realtime.load(); }
+
+    // 任意线程调用：到点时刻变了，让调度线程立刻重新取一次
+    void wakeUp() {
+#ifdef Q_OS_LINUX
+        if (m_eventFd >= 0) {
+            const quint64 one = 1;
+            (void)!::write(m_eventFd, &one, sizeof(one));
+            return;
+        }
+#endif
+        QMutexLocker lock(&m_mutex);
+        m_pending = true;
+        m_cond.wakeOne();
+    }
+
+    // 不能在调度线程自己里面调用
+    void stopAndWait() {
+        if (!isRunning()) return;
+        m_quit.store(true);
+        wakeUp();
+        wait();
+        m_quit.store(false);
+    }
+
+protected:
+    void run() override {
+        int appliedPriority = 0;
+        while (!m_quit.load()) {
+            const int prio = m_priority.load();
+            if (prio != appliedPriority) {
+                applyPriority(prio);
+                appliedPriority = prio;
+            }
+
+            const qint64 delayNs = m_tick();
+            if (m_quit.load()) break;
+#ifdef Q_OS_LINUX
+            if (m_timerFd >= 0 && m_eventFd >= 0) {
+                sleepFd(delayNs);
+                continue;
+            }
+#endif
+            sleepCond(delayNs);
+        }
+    }
+
+private:
+#ifdef Q_OS_LINUX
+    static qint64 monotonicNs() {
+        timespec ts;
+        ::clock_gettime(CLOCK_MONOTONIC, &ts);
+        return qint64(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+    }
+
+    void sleepFd(qint64 delayNs) {
+        itimerspec its = {};
+        if (delayNs >= 0) {
+            // 绝对时刻：中途被打断、被抢占都不会累积误差；0 会解除定时，至少给 1ns
+            const qint64 dueNs = monotonicNs() + (delayNs > 0 ? delayNs : 1);
+            its.it_value.tv_sec = time_t(dueNs / 1000000000LL);
+            its.it_value.tv_nsec = long(dueNs % 1000000000LL);
+        }
+        ::timerfd_settime(m_timerFd, TFD_TIMER_ABSTIME, &its, nullptr);
+
+        pollfd fds[2];
+        fds[0].fd = m_timerFd;
+        fds[0].events = POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = m_eventFd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        if (::poll(fds, 2, -1) <= 0) return; // EINTR：回到循环重新取
+
+        quint64 n = 0;
+        if (fds[0].revents & POLLIN) (void)!::read(m_timerFd, &n, sizeof(n));
+        if (fds[1].revents & POLLIN) (void)!::read(m_eventFd, &n, sizeof(n));
+    }
+#endif
+
+    void sleepCond(qint64 delayNs) {
+        QMutexLocker lock(&m_mutex);
+        if (!m_pending && !m_quit.load()) {
+            if (delayNs < 0) {
+                m_cond.wait(&m_mutex);
+            } else {
+                QDeadlineTimer deadline(Qt::PreciseTimer);
+                deadline.setPreciseRemainingTime(0, delayNs, Qt::PreciseTimer);
+                m_cond.wait(&m_mutex, deadline);
+            }
+        }
+        m_pending = false;
+    }
+
+    void applyPriority(int prio) {
+        m_realtime.store(false);
+#ifdef Q_OS_LINUX
+        sched_param sp;
+        if (prio > 0) {
+            sp.sched_priority = qBound(::sched_get_priority_min(SCHED_FIFO), prio,
+                                       ::sched_get_priority_max(SCHED_FIFO));
+            if (::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &sp) == 0) {
+                m_realtime.store(true);
+                return;
+            }
+        } else {
+            sp.sched_priority = 0;
+            ::pthread_setschedparam(::pthread_self(), SCHED_OTHER, &sp);
+            return;
+        }
+#endif
+        setPriority(prio > 0 ? QThread::TimeCriticalPriority : QThread::NormalPriority);
+    }
+
+private:
+    TickFn m_tick;
+    std::atomic<bool> m_quit{false};
+    std::atomic<int>  m_priority{0};
+    std::atomic<bool> m_realtime{false};
+
+    // 非 Linux / fd 创建失败时的退路
+    QMutex m_mutex;
+    QWaitCondition m_cond;
+    bool m_pending = false;
+
+#ifdef Q_OS_LINUX
+    int m_timerFd = -1;
+    int m_eventFd = -1;
+#endif
+};
@@ -0,0 +1,130 @@
+#include "WifiMonitor.h"
+
+WifiMonitor::WifiMonitor(QObject *parent)
+    : QObject(parent)
+{
+    m_poll.setInterval(m_pollMs);
+    connect(&m_poll, &QTimer::timeout, this, [this]() {
+        // 刚被 request() 刷新过就跳过这一轮
+        if (!cacheFresh(m_ttlMs)) startQuery();
+    });
+    connect(&m_watcher, &QFutureWatcherBase::finished, this, &WifiMonitor::onQueryFinished);
+}
+
+WifiMonitor::~WifiMonitor()
+{
+    m_watcher.disconnect(this);
+    for (QFutureInterface<NetshReply<WifiInfo>> &w : m_waiters) {
+        w.reportCanceled();
+        w.reportFinished();
+    }
+    m_waiters.clear();
+    // 正在跑的查询由 m_async 析构时取消
+}
+
+void WifiMonitor::setPollInterval(int ms)
+{
+    m_pollMs = qMax(1, ms);
+    m_poll.setInterval(m_pollMs);
+}
+
+void WifiMonitor::start()
+{
+    m_poll.start();
+    startQuery();
+}
+
+void WifiMonitor::stop()
+{
+    m_poll.stop();
+}
+
+bool WifiMonitor::cacheFresh(int maxAgeMs) const
+{
+    return m_hasValue && maxAgeMs > 0 && m_age.elapsed() < maxAgeMs;
+}
+
+QFuture<NetshReply<WifiInfo>> WifiMonitor::request(int maxAgeMs)
+{
+    QFutureInterface<NetshReply<WifiInfo>> fi;
+    fi.reportStarted();
+
+    if (cacheFresh(maxAgeMs < 0 ? m_ttlMs : maxAgeMs)) {
+        NetshReply<WifiInfo> reply;
+        reply.value = m_info;
+        reply.ok = true;
+        fi.reportResult(reply);
+        fi.reportFinished();
+        return fi.future();
+    }
+
+    m_waiters.append(fi);
+    startQuery();
+    return fi.future();
+}
+
+void WifiMonitor::startQuery()
+{
+    if (m_inflight) return; // 并到正在跑的那次
+    m_inflight = true;
+    ++m_queries;
+    m_watcher.setFuture(m_async.queryAll(m_deadlineMs));
+}
+
+WifiMonitor::Fields WifiMonitor::diff(const WifiInfo &a, const WifiInfo &b)
+{
+    Fields f = 0;
+    if (a.connected != b.connected || a.state != b.state) f |= Connection;
+    if (a.interfaceName != b.interfaceName || a.interfaceDesc != b.interfaceDesc || a.mac != b.mac) f |= Interface;
+    if (a.ssid != b.ssid) f |= Ssid;
+    if (a.bssid != b.bssid) f |= Bssid;
+    if (a.signalPct != b.signalPct) f |= Signal;
+    if (a.phyRateMbps != b.phyRateMbps || a.rxRateMbps != b.rxRateMbps || a.txRateMbps != b.txRateMbps) f |= Rates;
+    if (a.ipv4 != b.ipv4 || a.gateway != b.gateway) f |= Ip;
+    return f;
+}
+
+void WifiMonitor::onQueryFinished()
+{
+    m_inflight = false;
+
+    NetshReply<WifiInfo> reply;
+    const QFuture<NetshReply<WifiInfo>> f = m_watcher.future();
+    if (f.isCanceled() || f.resultCount() == 0) {
+        reply.errorText = "查询被取消";
+    } else {
+        reply = f.result();
+    }
+
+    // 先更新缓存，再交付等待者、发信号：槽里再调 request() 能直接拿到新缓存
+    Fields fields = 0;
+    if (reply.ok) {
+        fields = diff(m_info, reply.value);
+        m_info = reply.value;
+        m_hasValue = true;
+        m_age.start();
+    }
+
+    QList<QFutureInterface<NetshReply<WifiInfo>>> waiters;
+    waiters.swap(m_waiters);
+    for (QFutureInterface<NetshReply<WifiInfo>> &w : waiters) {
+        if (!w.isCanceled()) w.reportResult(reply);
+        w.reportFinished();
+    }
+
+    if (!reply.ok) {
+        emit queryFailed(reply.errorText, reply.timedOut);
+        return;
+    }
+    if (fields == 0) return;
+
+    const WifiInfo info = m_info; // 槽里可能触发新的查询，发信号用副本
+    if (fields & Connection) emit connectionChanged(info.connected, info.state);
+    if (fields & Interface)  emit interfaceChanged(info.interfaceName);
+    if (fields & Ssid)       emit ssidChanged(info.ssid);
+    if (fields & Bssid)      emit bssidChanged(info.bssid);
+    if (fields & Signal)     emit signalChanged(info.signalPct);
+    if (fields & Rates)      emit ratesChanged(info.phyRateMbps, info.rxRateMbps, info.txRateMbps);
+    if (fields & Ip)         emit ipChanged(info.ipv4, info.gateway);
+    emit changed(info, fields);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QList>
+#include <QTimer>
+
+#include "NetshWlanAsync.h"
+
+// WiFi 状态的共享服务：整个程序放一个，各个窗口连它的信号 / 调 request()，不要再各自定时 queryAll。
+// - 按 pollInterval 定时查询（NetshWlanAsync::queryAll），结果缓存 cacheTtl 毫秒
+// - 同一时刻最多一个查询在跑：缓存过期时的并发 request() 全部挂到这一次查询上
+// - 只对真正变了的字段发信号；查询失败不覆盖缓存
+// 所以 netsh 起进程的次数只跟轮询间隔有关，跟用的地方多少无关。
+// 对象和信号都在创建它的线程上（需要事件循环）。
+class WifiMonitor : public QObject
+{
+    Q_OBJECT
+public:
+    // 变化的字段（按位或）
+    enum Field : uint {
+        Connection = 0x01, // connected / state
+        Interface  = 0x02, // interfaceName / interfaceDesc / mac
+        Ssid       = 0x04,
+        Bssid      = 0x08,
+        Signal     = 0x10, // signalPct
+        Rates      = 0x20, // phy / rx / tx 速率
+        Ip         = 0x40, // ipv4 / gateway
+    };
+    using Fields = uint;
+
+    explicit WifiMonitor(QObject *parent = nullptr);
+    ~WifiMonitor() override;
+
+    // 轮询间隔（默认 2000ms），运行中修改立即生效
+    void setPollInterval(int ms);
+    int pollInterval() const { return m_pollMs; }
+
+    // 缓存有效期（默认 1000ms）：在这之内的 request() 和定时轮询都直接用缓存
+    void setCacheTtl(int ms) { m_ttlMs = ms; }
+    int cacheTtl() const { return m_ttlMs; }
+
+    // 单次查询的整体截止时间（同 NetshWlanAsync::queryAll）
+    void setQueryDeadline(int ms) { m_deadlineMs = ms; }
+    int queryDeadline() const { return m_deadlineMs; }
+
+    void start(); // 立即查一次，然后定时
+    void stop();  // 停止定时；正在跑的查询照常完成
+    bool isRunning() const { return m_poll.isActive(); }
+
+    // 缓存不超过 maxAgeMs（< 0 表示用 cacheTtl）时直接返回缓存，否则挂到（或发起）一次查询上。
+    // 每个调用方拿到自己的 future，cancel() 只影响自己，不会打断别人共用的那次查询。
+    QFuture<NetshReply<WifiInfo>> request(int maxAgeMs = -1);
+
+    // 忽略缓存强制查一次（已有查询在跑时并进去）
+    void refresh() { request(0); }
+
+    bool hasValue() const { return m_hasValue; }
+    const WifiInfo &last() const { return m_info; }
+    qint64 ageMs() const { return m_hasValue ? m_age.elapsed() : -1; }
+
+    bool isQuerying() const { return m_inflight; }
+    quint64 queryCount() const { return m_queries; } // 实际发起的查询次数
+
+    // a -> b 之间变了哪些字段
+    static Fields diff(const WifiInfo &a, const WifiInfo &b);
+
+signals:
+    // 有字段变化时发一次，fields 为变了的 Field 按位或（第一次查到的非默认值也算变化）
+    void changed(const WifiInfo &info, WifiMonitor::Fields fields);
+
+    // 按字段拆开的变化信号，都在 changed 之前发
+    void connectionChanged(bool connected, const QString &state);
+    void interfaceChanged(const QString &interfaceName);
+    void ssidChanged(const QString &ssid);
+    void bssidChanged(const QString &bssid);
+    void signalChanged(int signalPct);
+    void ratesChanged(int phyRateMbps, int rxRateMbps, int txRateMbps);
+    void ipChanged(const QString &ipv4, const QString &gateway);
+
+    void queryFailed(const QString &errorText, bool timedOut);
+
+private:
+    bool cacheFresh(int maxAgeMs) const;
+    void startQuery();
+    void onQueryFinished();
+
+    NetshWlanAsync m_async;
+    QTimer m_poll;
+    QFutureWatcher<NetshReply<WifiInfo>> m_watcher;
+    QList<QFutureInterface<NetshReply<WifiInfo>>> m_waiters; // 等这次查询的 request()
+
+    WifiInfo m_info;
+    QElapsedTimer m_age;
+    bool m_hasValue = false;
+    bool m_inflight = false;
+    quint64 m_queries = 0;
+
+    int m_pollMs = 2000;
+    int m_ttlMs = 1000;
+    int m_deadlineMs = 30000;
+};
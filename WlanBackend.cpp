@@ -0,0 +1,307 @@
+#include "WlanBackend.h"
+#include <QFile>
+#include <QtGlobal>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/wireless.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#ifdef Q_OS_LINUX
+namespace {
+
+// rtnetlink 订阅：不解析内容，只当“接口有变化”的信号，具体状态由调用方再查
+class NetlinkWatch : public IWlanBackend::ChangeWatch
+{
+public:
+    NetlinkWatch()
+    {
+        m_fd = ::socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+        if (m_fd < 0) return;
+        sockaddr_nl addr;
+        std::memset(&addr, 0, sizeof addr);
+        addr.nl_family = AF_NETLINK;
+        addr.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR;
+        if (::bind(m_fd, reinterpret_cast<sockaddr *>(&addr), sizeof addr) != 0) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+    ~NetlinkWatch() override
+    {
+        if (m_fd >= 0) ::close(m_fd);
+    }
+
+    bool isValid() const { return m_fd >= 0; }
+    int fd() const override { return m_fd; }
+
+    bool wait(int timeoutMs) override
+    {
+        pollfd p = { m_fd, POLLIN, 0 };
+        return ::poll(&p, 1, qMax(0, timeoutMs)) > 0;
+    }
+
+    void drain() override
+    {
+        char buf[8192];
+        while (::recv(m_fd, buf, sizeof buf, 0) > 0) {}
+    }
+
+private:
+    int m_fd = -1;
+};
+
+} // namespace
+#endif
+
+bool IWlanBackend::queryAll(WifiInfo &info, QString *errorText)
+{
+    if (!queryWifi(info, errorText))
+        return false;
+    // IP 失败不影响 WiFi 主信息
+    if (!info.interfaceName.isEmpty())
+        queryIpForInterface(info.interfaceName, info, nullptr);
+    return true;
+}
+
+LinuxWlanBackend::LinuxWlanBackend(const QString &interfaceName)
+    : m_iface(interfaceName)
+{
+}
+
+LinuxWlanBackend::LinuxWlanBackend(const QString &interfaceName, const Paths &paths)
+    : m_iface(interfaceName)
+    , m_paths(paths)
+{
+}
+
+QString LinuxWlanBackend::readFile(const QString &path) const
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return QString();
+    // /proc 下的文件 size() 是 0，只能读到 EOF
+    return QString::fromUtf8(f.readAll());
+}
+
+QString LinuxWlanBackend::sysNetFile(const QString &iface, const QString &name) const
+{
+    return readFile(m_paths.sysRoot + "/class/net/" + iface + "/" + name).trimmed();
+}
+
+// Inter-| sta-|   Quality        |   Discarded packets               | Missed | WE
+//  face | tus | link level noise |  nwid  crypt   frag  retry   misc | beacon | 22
+// wlp2s0: 0000   54.  -56.  -256        0      0      0      0     35        0
+QList<LinuxWlanBackend::WirelessEntry> LinuxWlanBackend::parseProcWireless(const QString &text)
+{
+    QList<WirelessEntry> list;
+    const QStringList lines = text.split('\n');
+    for (const QString &raw : lines) {
+        const int colon = raw.indexOf(':');
+        if (colon <= 0) continue;
+        const QString iface = raw.left(colon).trimmed();
+        if (iface.contains('|')) continue; // 表头
+
+        const QStringList cols = raw.mid(colon + 1).simplified().split(' ');
+        if (cols.size() < 3) continue;
+
+        auto number = [](QString s) {
+            if (s.endsWith(".")) s.chop(1); // 数值后面的 '.' 表示已更新
+            return s.toInt();
+        };
+        WirelessEntry e;
+        e.iface = iface;
+        e.link = number(cols.at(1));
+        e.level = number(cols.at(2));
+        list << e;
+    }
+    return list;
+}
+
+// Iface   Destination  Gateway   Flags  RefCnt  Use  Metric  Mask  ...
+// wlp2s0  00000000     0101A8C0  0003   0       0    600     00000000
+// 地址是按本机字节序打印的网络序整数
+QString LinuxWlanBackend::parseProcRouteGateway(const QString &text, const QString &iface)
+{
+    const uint RTF_GATEWAY_FLAG = 0x2;
+    QString best;
+    int bestMetric = -1;
+
+    const QStringList lines = text.split('\n');
+    for (const QString &raw : lines) {
+        const QStringList cols = raw.simplified().split(' ');
+        if (cols.size() < 7 || cols.at(0) != iface) continue;
+
+        bool ok = false;
+        const uint dest = cols.at(1).toUInt(&ok, 16);
+        if (!ok || dest != 0) continue;
+        const uint flags = cols.at(3).toUInt(&ok, 16);
+        if (!ok || !(flags & RTF_GATEWAY_FLAG)) continue;
+        const quint32 gw = cols.at(2).toUInt(&ok, 16);
+        if (!ok || gw == 0) continue;
+        const int metric = cols.at(6).toInt();
+        if (bestMetric >= 0 && metric >= bestMetric) continue;
+
+        uchar b[4];
+        std::memcpy(b, &gw, sizeof b);
+        best = QString("%1.%2.%3.%4").arg(b[0]).arg(b[1]).arg(b[2]).arg(b[3]);
+        bestMetric = metric;
+    }
+    return best;
+}
+
+int LinuxWlanBackend::qualityToPercent(int link)
+{
+    // 无线扩展的链路质量没有统一满分，cfg80211 的驱动都是 70
+    return qBound(0, link * 100 / 70, 100);
+}
+
+bool LinuxWlanBackend::queryWifi(WifiInfo &info, QString *errorText)
+{
+    const QList<WirelessEntry> entries = parseProcWireless(readFile(m_paths.procRoot + "/net/wireless"));
+    if (entries.isEmpty()) {
+        if (errorText) *errorText = "未找到无线网卡（/proc/net/wireless 为空）";
+        return false;
+    }
+
+    const WirelessEntry *picked = nullptr;
+    for (const WirelessEntry &e : entries) {
+        if (!m_iface.isEmpty()) {
+            if (e.iface == m_iface) picked = &e;
+        } else if (e.link > 0) {
+            picked = &e;
+        }
+        if (picked) break;
+    }
+    if (!picked && m_iface.isEmpty()) picked = &entries.first();
+    if (!picked) {
+        if (errorText) *errorText = QString("无线网卡 %1 不存在").arg(m_iface);
+        return false;
+    }
+
+    info.interfaceName = picked->iface;
+    info.mac = sysNetFile(picked->iface, "address");
+    for (const QString &line : sysNetFile(picked->iface, "device/uevent").split('\n')) {
+        if (line.startsWith("DRIVER=")) info.interfaceDesc = line.mid(7);
+    }
+
+    LinkInfo link;
+    readLink(picked->iface, link);
+    info.ssid = link.ssid;
+    info.bssid = link.bssid;
+    info.connected = !link.ssid.isEmpty() || !link.bssid.isEmpty();
+
+    const QString operstate = sysNetFile(picked->iface, "operstate");
+    info.state = info.connected ? QString("connected") : (operstate.isEmpty() ? QString("disconnected") : operstate);
+
+    info.signalPct = info.connected ? qualityToPercent(picked->link) : -1;
+    info.phyRateMbps = -1;
+    info.rxRateMbps = -1;
+    info.txRateMbps = link.bitrateMbps; // 无线扩展只给发送速率
+    return true;
+}
+
+bool LinuxWlanBackend::queryIpForInterface(const QString &interfaceName, WifiInfo &io, QString *errorText)
+{
+    if (interfaceName.trimmed().isEmpty()) {
+        if (errorText) *errorText = "interfaceName 为空，无法定向解析 IP/网关";
+        return false;
+    }
+
+    io.ipv4 = readIpv4(interfaceName);
+    io.gateway = parseProcRouteGateway(readFile(m_paths.procRoot + "/net/route"), interfaceName);
+    if (io.ipv4.isEmpty() && io.gateway.isEmpty()) {
+        if (errorText) *errorText = "未能解析到 IPv4/默认网关（getifaddrs / /proc/net/route）。";
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<IWlanBackend::ChangeWatch> LinuxWlanBackend::watchChanges()
+{
+#ifdef Q_OS_LINUX
+    std::unique_ptr<NetlinkWatch> w(new NetlinkWatch);
+    if (w->isValid()) return std::unique_ptr<ChangeWatch>(w.release());
+#endif
+    return nullptr;
+}
+
+bool LinuxWlanBackend::readLink(const QString &iface, LinkInfo &link)
+{
+#ifdef Q_OS_LINUX
+    const int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) return false;
+
+    const QByteArray name = iface.toLocal8Bit();
+    auto request = [&](iwreq &wrq) {
+        std::memset(&wrq, 0, sizeof wrq);
+        std::strncpy(wrq.ifr_name, name.constData(), IFNAMSIZ - 1);
+    };
+
+    iwreq wrq;
+    char essid[IW_ESSID_MAX_SIZE + 1] = {};
+    request(wrq);
+    wrq.u.essid.pointer = essid;
+    wrq.u.essid.length = IW_ESSID_MAX_SIZE;
+    if (::ioctl(fd, SIOCGIWESSID, &wrq) == 0)
+        link.ssid = QString::fromUtf8(essid, qMin<int>(wrq.u.essid.length, IW_ESSID_MAX_SIZE));
+
+    request(wrq);
+    if (::ioctl(fd, SIOCGIWAP, &wrq) == 0) {
+        const uchar *ap = reinterpret_cast<const uchar *>(wrq.u.ap_addr.sa_data);
+        bool any = false;
+        QStringList parts;
+        for (int i = 0; i < 6; ++i) {
+            any = any || ap[i] != 0;
+            parts << QString("%1").arg(ap[i], 2, 16, QChar('0'));
+        }
+        if (any) link.bssid = parts.join(":"); // 全 0 = 没有关联
+    }
+
+    request(wrq);
+    if (::ioctl(fd, SIOCGIWRATE, &wrq) == 0 && wrq.u.bitrate.value > 0)
+        link.bitrateMbps = int(wrq.u.bitrate.value / 1000000);
+
+    ::close(fd);
+    return true;
+#else
+    Q_UNUSED(iface);
+    Q_UNUSED(link);
+    return false;
+#endif
+}
+
+QString LinuxWlanBackend::readIpv4(const QString &iface)
+{
+#ifdef Q_OS_LINUX
+    ifaddrs *list = nullptr;
+    if (::getifaddrs(&list) != 0) return QString();
+
+    QString ip;
+    const QByteArray name = iface.toLocal8Bit();
+    for (ifaddrs *a = list; a; a = a->ifa_next) {
+        if (!a->ifa_addr || a->ifa_addr->sa_family != AF_INET) continue;
+        if (std::strcmp(name.constData(), a->ifa_name) != 0) continue;
+        char buf[INET_ADDRSTRLEN] = {};
+        const sockaddr_in *sin = reinterpret_cast<const sockaddr_in *>(a->ifa_addr);
+        if (::inet_ntop(AF_INET, &sin->sin_addr, buf, sizeof buf)) {
+            ip = QString::fromLatin1(buf);
+            break;
+        }
+    }
+    ::freeifaddrs(list);
+    return ip;
+#else
+    Q_UNUSED(iface);
+    return QString();
+#endif
+}
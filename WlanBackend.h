@@ -0,0 +1,97 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <memory>
+
+#include "NetshWlanReaderV.h"
+
+// WiFi 信息来源：NetshWlanReader 默认解析 netsh / ipconfig 的输出，设置了后端
+// （NetshWlanReader::setBackend）时 queryAll / queryWifi / queryIpForInterface 改走后端
+class IWlanBackend
+{
+public:
+    virtual ~IWlanBackend() = default;
+
+    // 同 NetshWlanReader::queryWifi；拿不到任何信息时返回 false 并填 errorText
+    virtual bool queryWifi(WifiInfo &info, QString *errorText) = 0;
+
+    // 同 NetshWlanReader::queryIpForInterface：只填 ipv4 / gateway
+    virtual bool queryIpForInterface(const QString &interfaceName, WifiInfo &io, QString *errorText) = 0;
+
+    // 默认 = queryWifi + queryIpForInterface（IP 失败不影响 WiFi 主信息）
+    virtual bool queryAll(WifiInfo &info, QString *errorText);
+
+    // 接口变化通知：连接/断开后确认状态时用来代替盲等，通知到了再查
+    class ChangeWatch
+    {
+    public:
+        virtual ~ChangeWatch() = default;
+        virtual int fd() const = 0;           // 可读 = 有变化（异步版挂 QSocketNotifier）
+        virtual bool wait(int timeoutMs) = 0; // 同步版：有变化返回 true，超时 false
+        virtual void drain() = 0;             // 读掉已经到的通知
+    };
+    // 不支持返回 nullptr（调用方退回轮询）；要在发命令之前订阅，免得漏掉
+    virtual std::unique_ptr<ChangeWatch> watchChanges() { return nullptr; }
+};
+
+// Linux：不起任何子进程
+// - 无线接口和信号质量：/proc/net/wireless
+// - 默认网关：/proc/net/route
+// - MAC / operstate / 驱动名：/sys/class/net/<iface>/
+// - SSID / BSSID / 当前速率：无线扩展 ioctl（SIOCGIWESSID / SIOCGIWAP / SIOCGIWRATE）
+// - IPv4：getifaddrs
+// - 变化通知：rtnetlink（RTMGRP_LINK / RTMGRP_IPV4_IFADDR，关联/断开时内核会发 RTM_NEWLINK）
+// 文件都按 procRoot / sysRoot 拼路径，测试时指向夹具目录；ioctl / getifaddrs 两部分是虚函数，测试里可以替换。
+class LinuxWlanBackend : public IWlanBackend
+{
+public:
+    struct Paths
+    {
+        QString procRoot = "/proc";
+        QString sysRoot  = "/sys";
+    };
+
+    // interfaceName 为空时自动选：/proc/net/wireless 里第一个有链路质量的，都没有就第一个
+    explicit LinuxWlanBackend(const QString &interfaceName = QString());
+    LinuxWlanBackend(const QString &interfaceName, const Paths &paths);
+
+    bool queryWifi(WifiInfo &info, QString *errorText) override;
+    bool queryIpForInterface(const QString &interfaceName, WifiInfo &io, QString *errorText) override;
+    std::unique_ptr<ChangeWatch> watchChanges() override;
+
+    // /proc/net/wireless 的一行
+    struct WirelessEntry
+    {
+        QString iface;
+        int     link  = 0;   // 链路质量（大多数驱动满分 70）
+        int     level = 0;   // 信号强度，dBm
+    };
+    static QList<WirelessEntry> parseProcWireless(const QString &text);
+
+    // /proc/net/route 里 iface 的默认网关（metric 最小的那条），没有返回空
+    static QString parseProcRouteGateway(const QString &text, const QString &iface);
+
+    // 链路质量 -> 0~100
+    static int qualityToPercent(int link);
+
+protected:
+    struct LinkInfo
+    {
+        QString ssid;
+        QString bssid;
+        int     bitrateMbps = -1;
+    };
+    // 系统调用部分（测试里替换成固定值）
+    virtual bool readLink(const QString &iface, LinkInfo &link);
+    virtual QString readIpv4(const QString &iface);
+
+    QString readFile(const QString &path) const;
+
+private:
+    QString sysNetFile(const QString &iface, const QString &name) const;
+
+    QString m_iface;
+    Paths   m_paths;
+};
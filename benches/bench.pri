@@ -0,0 +1,7 @@
+# 基准程序共用：无界面控制台程序，源码都在仓库根目录
+QT -= gui
+CONFIG += console release
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/..
+HEADERS += $$PWD/../BenchUtil.h
@@ -0,0 +1,6 @@
+include(../bench.pri)
+TARGET = NetshParseBench
+
+SOURCES += ../../NetshParseBench.cpp \
+           ../../NetshOutputParser.cpp
+HEADERS += ../../NetshOutputParser.h
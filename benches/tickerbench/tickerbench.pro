@@ -0,0 +1,12 @@
+include(../bench.pri)
+TARGET = TickerBench
+
+SOURCES += ../../TickerBench.cpp
+# 只有头文件的 Q_OBJECT 类要列在 HEADERS 里才会跑 moc
+HEADERS += ../../SimpleMsTicker.h \
+           ../../MultiMsTicker.h \
+           ../../TickerThread.h \
+           ../../TickerStats.h \
+           ../../MpscQueue.h
+# GetProcessMemoryInfo
+win32: LIBS += -lpsapi
@@ -0,0 +1,97 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QFile>
+#include <thread>
+#include "CmdSession.h"
+
+// 用 /bin/sh 当常驻壳（同 Windows 上的 cmd /q：命令走 stdin，输出按 echo 哨兵切）
+class TestCmdSession : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void splitsOutputAtMarkers();
+    void timeoutKillsAndRestarts();
+    void restartsAfterShellDies();
+    void otherThreadKeepsShell();
+
+private:
+    static ShellCmdSession::Shell shell() { return ShellCmdSession::posixShell(); }
+};
+
+void TestCmdSession::initTestCase()
+{
+    if (!QFile::exists("/bin/sh"))
+        QSKIP("needs /bin/sh");
+}
+
+// 每条命令只拿到自己的输出：没有换行结尾、空输出、多行都不能串到下一条
+void TestCmdSession::splitsOutputAtMarkers()
+{
+    ShellCmdSession s(shell());
+    QCOMPARE(s.run("echo hello", 5000), QString("hello\n"));
+    QCOMPARE(s.run("printf 'a\\nb\\n'", 5000), QString("a\nb\n"));
+    QCOMPARE(s.run("printf 'no newline'", 5000), QString("no newline"));
+    QCOMPARE(s.run("true", 5000), QString());
+    QCOMPARE(s.run("echo again", 5000), QString("again\n"));
+    // stderr 丢掉
+    QCOMPARE(s.run("echo oops 1>&2; echo out", 5000), QString("out\n"));
+
+    QVERIFY(s.isAlive());
+    QCOMPARE(s.restartCount(), 0);
+}
+
+// 超时：返回空串并杀掉壳（后面的输出对不上哨兵了），下一条命令重启
+void TestCmdSession::timeoutKillsAndRestarts()
+{
+    ShellCmdSession s(shell());
+    QCOMPARE(s.run("echo up", 5000), QString("up\n"));
+
+    QElapsedTimer clock;
+    clock.start();
+    QCOMPARE(s.run("sleep 5; echo late", 300), QString());
+    QVERIFY2(clock.elapsed() < 3000, qPrintable(QString::number(clock.elapsed())));
+    QVERIFY(!s.isAlive());
+
+    // 上一条的 "late" 不能混进来
+    QCOMPARE(s.run("echo fresh", 5000), QString("fresh\n"));
+    QVERIFY(s.isAlive());
+    QCOMPARE(s.restartCount(), 1);
+}
+
+// 壳进程自己退出（被杀）：当前命令返回空串，下一条重启
+void TestCmdSession::restartsAfterShellDies()
+{
+    ShellCmdSession s(shell());
+    const QString pid = s.run("echo $$", 5000);
+    QVERIFY(!pid.isEmpty());
+
+    QCOMPARE(s.run("kill -9 $$", 5000), QString());
+    QVERIFY(!s.isAlive());
+
+    const QString pid2 = s.run("echo $$", 5000);
+    QVERIFY(!pid2.isEmpty());
+    QVERIFY(pid2 != pid);
+    QCOMPARE(s.restartCount(), 1);
+    QCOMPARE(s.run("echo ok", 5000), QString("ok\n"));
+}
+
+// 别的线程调用：转到会话的工作线程上跑，还是同一个壳进程
+void TestCmdSession::otherThreadKeepsShell()
+{
+    ShellCmdSession s(shell());
+    const QString pid = s.run("echo $$", 5000);
+    QVERIFY(!pid.isEmpty());
+
+    QString fromThread;
+    std::thread t([&s, &fromThread] { fromThread = s.run("echo $$", 5000); });
+    t.join();
+
+    QCOMPARE(fromThread, pid);
+    QCOMPARE(s.restartCount(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestCmdSession)
+
+#include "tst_cmdsession.moc"
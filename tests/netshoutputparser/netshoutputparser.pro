@@ -0,0 +1,9 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase console
+CONFIG -= app_bundle
+TARGET = tst_netshoutputparser
+
+INCLUDEPATH += ../..
+SOURCES += tst_netshoutputparser.cpp \
+           ../../NetshOutputParser.cpp
@@ -0,0 +1,168 @@
+#include <QtTest>
+#include <QFile>
+#include "NetshOutputParser.h"
+
+// 夹具就是 NetshParseBench 的内置语料（CRLF，UTF-8），另加两份没有网关的；
+// 也可以直接拿来跑基准：NetshParseBench --corpus tests/netshoutputparser/fixtures
+class TestNetshOutputParser : public QObject
+{
+    Q_OBJECT
+private slots:
+    void wlanInterfacesZh();
+    void wlanInterfacesEn();
+    void netshIpConfig_data();
+    void netshIpConfig();
+    void ipconfig_data();
+    void ipconfig();
+    void profiles_data();
+    void profiles();
+    void helpers();
+
+private:
+    static QString fixture(const QString &name);
+};
+
+QString TestNetshOutputParser::fixture(const QString &name)
+{
+    QFile f(QFINDTESTDATA("fixtures/" + name));
+    if (!f.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromUtf8(f.readAll());
+}
+
+void TestNetshOutputParser::wlanInterfacesZh()
+{
+    const QString text = fixture("interfaces-zh.txt");
+    QVERIFY(!text.isEmpty());
+
+    WifiInfo w;
+    NetshOutputParser::parseWlanInterfaces(text, w);
+    QCOMPARE(w.interfaceName, QString("WLAN"));
+    QCOMPARE(w.interfaceDesc, QString("Intel(R) Wi-Fi 6 AX203"));
+    QCOMPARE(w.state, QString::fromUtf8("已连接"));
+    QVERIFY(w.connected);
+    QCOMPARE(w.ssid, QString("AMNet_VPN_5G"));
+    QCOMPARE(w.bssid, QString("c4:70:ab:20:81:df"));
+    QCOMPARE(w.mac, QString("90:09:df:51:20:b1"));
+    QCOMPARE(w.signalPct, 92);
+    QCOMPARE(w.rxRateMbps, 1201);
+    QCOMPARE(w.txRateMbps, 1201);
+    // 没有单独的“速率”行；“承载网络状态”不能当成“状态”
+    QCOMPARE(w.phyRateMbps, -1);
+}
+
+void TestNetshOutputParser::wlanInterfacesEn()
+{
+    const QString text = fixture("interfaces-en.txt");
+    QVERIFY(!text.isEmpty());
+
+    WifiInfo w;
+    NetshOutputParser::parseWlanInterfaces(text, w);
+    QCOMPARE(w.interfaceName, QString("Wi-Fi"));
+    QCOMPARE(w.interfaceDesc, QString("Intel(R) Wi-Fi 6 AX201 160MHz"));
+    QCOMPARE(w.state, QString("connected"));
+    QVERIFY(w.connected);
+    QCOMPARE(w.ssid, QString("Office-5G"));
+    QCOMPARE(w.bssid, QString("70:3a:0e:44:55:66"));
+    QCOMPARE(w.mac, QString("3c:58:c2:11:22:33"));
+    QCOMPARE(w.signalPct, 88);
+    QCOMPARE(w.rxRateMbps, 866); // 866.7 只取整数部分
+    QCOMPARE(w.txRateMbps, 585);
+    QCOMPARE(w.phyRateMbps, -1); // "Radio type" 不能当成 "Rate"
+}
+
+void TestNetshOutputParser::netshIpConfig_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("ipv4");
+    QTest::addColumn<QString>("gateway");
+
+    // zh 里 WINS 服务器是“无”，不是网关，不能影响结果
+    QTest::newRow("zh")              << "netship-zh.txt"      << "192.168.100.212" << "192.168.100.1";
+    QTest::newRow("en")              << "netship-en.txt"      << "192.168.1.23"    << "192.168.1.1";
+    QTest::newRow("zh gateway none") << "netship-nogw-zh.txt" << "169.254.23.7"    << "";
+}
+
+void TestNetshOutputParser::netshIpConfig()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, ipv4);
+    QFETCH(QString, gateway);
+
+    const QString text = fixture(file);
+    QVERIFY(!text.isEmpty());
+    WifiInfo w;
+    QVERIFY(NetshOutputParser::parseNetshIpConfig(text, w));
+    QCOMPARE(w.ipv4, ipv4);
+    QCOMPARE(w.gateway, gateway);
+}
+
+void TestNetshOutputParser::ipconfig_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("iface");
+    QTest::addColumn<bool>("found");
+    QTest::addColumn<QString>("ipv4");
+    QTest::addColumn<QString>("gateway");
+
+    // 多个适配器：只取 WLAN 那一段，前面断开的适配器和后面的蓝牙/以太网都不能混进来
+    QTest::newRow("zh")      << "ipconfig-zh.txt" << "WLAN" << true << "192.168.100.212" << "192.168.100.1";
+    QTest::newRow("en")      << "ipconfig-en.txt" << "WLAN" << true << "192.168.1.23"    << "192.168.1.1";
+    QTest::newRow("zh no gateway, next adapter has one")
+        << "ipconfig-nogw-zh.txt" << "WLAN" << true << "169.254.23.7" << "";
+    QTest::newRow("zh disconnected adapter")
+        << "ipconfig-zh.txt" << QString::fromUtf8("蓝牙网络连接") << false << "" << "";
+    QTest::newRow("unknown adapter") << "ipconfig-en.txt" << "wlan9" << false << "" << "";
+}
+
+void TestNetshOutputParser::ipconfig()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, iface);
+    QFETCH(bool, found);
+    QFETCH(QString, ipv4);
+    QFETCH(QString, gateway);
+
+    const QString text = fixture(file);
+    QVERIFY(!text.isEmpty());
+    WifiInfo w;
+    QCOMPARE(NetshOutputParser::parseIpconfig(text, iface, w), found);
+    QCOMPARE(w.ipv4, ipv4);
+    QCOMPARE(w.gateway, gateway);
+}
+
+void TestNetshOutputParser::profiles_data()
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QStringList>("names");
+
+    // 组策略段里的 <无>/<None> 不算
+    QTest::newRow("zh") << "profiles-zh.txt"
+                        << (QStringList() << "AMNet_VPN_5G" << "AMNet" << "Guest-2.4G" << QString::fromUtf8("会议室"));
+    QTest::newRow("en") << "profiles-en.txt" << (QStringList() << "Office-5G" << "Office" << "Home");
+}
+
+void TestNetshOutputParser::profiles()
+{
+    QFETCH(QString, file);
+    QFETCH(QStringList, names);
+
+    const QString text = fixture(file);
+    QVERIFY(!text.isEmpty());
+    QCOMPARE(NetshOutputParser::parseProfiles(text), names);
+}
+
+void TestNetshOutputParser::helpers()
+{
+    // 全角冒号
+    QCOMPARE(NetshOutputParser::valueAfterColon(QString::fromUtf8("信号：  75% ")).toString(), QString("75%"));
+    QVERIFY(NetshOutputParser::valueAfterColon(QString("no colon")).isEmpty());
+    QCOMPARE(NetshOutputParser::parseFirstInt(QString(" 866.7")), 866);
+    QCOMPARE(NetshOutputParser::parseFirstInt(QString("n/a")), -1);
+    QVERIFY(NetshOutputParser::textIsConnected(QString::fromUtf8("已连接")));
+    QVERIFY(NetshOutputParser::textIsConnected(QString("Connected")));
+    QVERIFY(!NetshOutputParser::textIsConnected(QString::fromUtf8("已断开连接")));
+}
+
+QTEST_APPLESS_MAIN(TestNetshOutputParser)
+
+#include "tst_netshoutputparser.moc"
@@ -0,0 +1,13 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase console
+CONFIG -= app_bundle
+TARGET = tst_netshwlanasync
+
+INCLUDEPATH += ../..
+SOURCES += tst_netshwlanasync.cpp \
+           ../../NetshWlanAsync.cpp \
+           ../../NetshWlanReaderV.cpp \
+           ../../NetshOutputParser.cpp \
+           ../../WlanBackend.cpp
+HEADERS += ../../NetshWlanAsync.h
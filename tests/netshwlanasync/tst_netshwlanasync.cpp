@@ -0,0 +1,233 @@
+#include <QtTest>
+#include <QFile>
+#include <QTemporaryDir>
+#include "NetshWlanAsync.h"
+#include "WlanBackend.h"
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#endif
+
+// 信息后端换成固定值，记下被查了几次
+class StubBackend : public IWlanBackend
+{
+public:
+    bool queryWifi(WifiInfo &info, QString *errorText) override
+    {
+        ++queries;
+        if (wifi.interfaceName.isEmpty()) {
+            if (errorText) *errorText = "no wifi";
+            return false;
+        }
+        info = wifi;
+        return true;
+    }
+    bool queryIpForInterface(const QString &, WifiInfo &io, QString *) override
+    {
+        ++queries;
+        io.ipv4 = wifi.ipv4;
+        io.gateway = wifi.gateway;
+        return true;
+    }
+
+    WifiInfo wifi;
+    int queries = 0;
+};
+
+// 命令用 /bin/sh 跑：先把自己的 pid 写进文件，再换成长时间的 sleep（命令文本成了 $0，不执行）
+class TestNetshWlanAsync : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+    void cleanup();
+
+    void backendReplyIsDeferred();
+    void invalidArgumentsAreDeferred();
+    void cancelAllBeforeBackendQuery();
+    void futureCancelSuppressesReply();
+    void deadlineDuringConfirm();
+    void cancelKillsCommand();
+    void deadlineKillsCommand();
+
+private:
+    bool useSleepingShell(NetshWlanAsync &a);
+    qint64 readPid() const;
+    static bool processAlive(qint64 pid);
+
+    std::shared_ptr<IWlanBackend> m_savedBackend;
+    NetshWlanReader::ConfirmBackoff m_savedBackoff;
+    std::shared_ptr<StubBackend> m_stub;
+    QTemporaryDir m_dir;
+};
+
+void TestNetshWlanAsync::init()
+{
+    m_savedBackend = NetshWlanReader::backend();
+    m_savedBackoff = NetshWlanReader::confirmBackoff();
+    m_stub = std::make_shared<StubBackend>();
+    m_stub->wifi.interfaceName = "wlan0";
+    m_stub->wifi.ssid = "Office-5G";
+    m_stub->wifi.connected = true;
+    m_stub->wifi.ipv4 = "192.168.1.23";
+    m_stub->wifi.gateway = "192.168.1.1";
+    NetshWlanReader::setBackend(m_stub);
+    QFile::remove(m_dir.filePath("pid"));
+}
+
+void TestNetshWlanAsync::cleanup()
+{
+    NetshWlanReader::setBackend(m_savedBackend);
+    NetshWlanReader::setConfirmBackoff(m_savedBackoff);
+    m_stub.reset();
+}
+
+bool TestNetshWlanAsync::useSleepingShell(NetshWlanAsync &a)
+{
+    if (!m_dir.isValid() || !QFile::exists("/bin/sh")) return false;
+    a.setCommandShell("/bin/sh", {"-c", QString("echo $$ > '%1'; exec sleep 30").arg(m_dir.filePath("pid"))});
+    return true;
+}
+
+qint64 TestNetshWlanAsync::readPid() const
+{
+    QFile f(m_dir.filePath("pid"));
+    if (!f.open(QIODevice::ReadOnly)) return 0;
+    return f.readAll().trimmed().toLongLong();
+}
+
+bool TestNetshWlanAsync::processAlive(qint64 pid)
+{
+#ifdef Q_OS_UNIX
+    return ::kill(pid_t(pid), 0) == 0; // 没回收的僵尸也算活着：QProcess 回收了才算结束
+#else
+    Q_UNUSED(pid);
+    return false;
+#endif
+}
+
+// 走后端不起进程，但结果也要等调用返回、回到事件循环之后才交付
+void TestNetshWlanAsync::backendReplyIsDeferred()
+{
+    NetshWlanAsync a;
+    QSignalSpy spy(&a, &NetshWlanAsync::wifiReady);
+    QFuture<NetshReply<WifiInfo>> f = a.queryAll();
+    QVERIFY(!f.isFinished());
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(m_stub->queries, 0);
+
+    QTRY_VERIFY(f.isFinished());
+    QCOMPARE(spy.count(), 1);
+    const NetshReply<WifiInfo> r = f.result();
+    QVERIFY(r.ok);
+    QCOMPARE(r.value.ssid, QString("Office-5G"));
+    QCOMPARE(r.value.gateway, QString("192.168.1.1"));
+    QCOMPARE(a.pendingCount(), 0);
+}
+
+void TestNetshWlanAsync::invalidArgumentsAreDeferred()
+{
+    NetshWlanAsync a;
+    QSignalSpy ipSpy(&a, &NetshWlanAsync::ipReady);
+    QSignalSpy connectSpy(&a, &NetshWlanAsync::connectFinished);
+    QFuture<NetshReply<WifiInfo>> ip = a.queryIpForInterface("  ");
+    QFuture<NetshReply<bool>> conn = a.connectToProfile(QString());
+    QVERIFY(!ip.isFinished());
+    QVERIFY(!conn.isFinished());
+    QCOMPARE(ipSpy.count() + connectSpy.count(), 0);
+
+    QTRY_VERIFY(ip.isFinished() && conn.isFinished());
+    QVERIFY(!ip.result().ok);
+    QVERIFY(!ip.result().errorText.isEmpty());
+    QVERIFY(!conn.result().ok);
+    QVERIFY(!conn.result().errorText.isEmpty());
+    QCOMPARE(ipSpy.count(), 1);
+    QCOMPARE(connectSpy.count(), 1);
+    QCOMPARE(m_stub->queries, 0);
+}
+
+// 调用返回后马上取消：后端一次都不查，也不发信号
+void TestNetshWlanAsync::cancelAllBeforeBackendQuery()
+{
+    NetshWlanAsync a;
+    QSignalSpy spy(&a, &NetshWlanAsync::wifiReady);
+    QFuture<NetshReply<WifiInfo>> f = a.queryWifi();
+    a.cancelAll();
+    QVERIFY(f.isCanceled());
+    QCOMPARE(a.pendingCount(), 0);
+
+    QTest::qWait(50);
+    QCOMPARE(m_stub->queries, 0);
+    QCOMPARE(spy.count(), 0);
+}
+
+// future.cancel() 的通知要经过事件循环，先到期的后端查询不能再交付结果
+void TestNetshWlanAsync::futureCancelSuppressesReply()
+{
+    NetshWlanAsync a;
+    QSignalSpy spy(&a, &NetshWlanAsync::wifiReady);
+    QFuture<NetshReply<WifiInfo>> f = a.queryWifi();
+    f.cancel();
+
+    QTRY_COMPARE(a.pendingCount(), 0);
+    QTest::qWait(50);
+    QVERIFY(f.isCanceled());
+    QCOMPARE(spy.count(), 0);
+}
+
+// 连接命令没报成功、后端一直看不到目标 SSID：确认预算很长，整体截止时间先到
+void TestNetshWlanAsync::deadlineDuringConfirm()
+{
+    NetshWlanReader::ConfirmBackoff b = m_savedBackoff;
+    b.initialMs = 20;
+    b.maxMs = 50;
+    b.connectBudgetMs = 60000;
+    NetshWlanReader::setConfirmBackoff(b);
+
+    NetshWlanAsync a;
+    // 命令立刻退出、没有输出（没有 /bin/sh 时起不来，也是没有输出）
+    a.setCommandShell("/bin/sh", {"-c", "exit 0"});
+    QFuture<NetshReply<bool>> f = a.connectToProfile("Home", "Home", QString(), 300);
+
+    QTRY_VERIFY_WITH_TIMEOUT(f.isFinished(), 5000);
+    const NetshReply<bool> r = f.result();
+    QVERIFY(!r.ok);
+    QVERIFY(r.timedOut);
+    QVERIFY2(r.elapsedMs >= 250 && r.elapsedMs < 3000, qPrintable(QString::number(r.elapsedMs)));
+    QVERIFY(m_stub->queries > 1); // 确认期间一直在查
+}
+
+void TestNetshWlanAsync::cancelKillsCommand()
+{
+    NetshWlanReader::setBackend(nullptr); // 走命令
+    NetshWlanAsync a;
+    if (!useSleepingShell(a)) QSKIP("needs /bin/sh");
+
+    QFuture<NetshReply<WifiInfo>> f = a.queryWifi(60000);
+    QTRY_VERIFY(readPid() > 0);
+    const qint64 pid = readPid();
+    QVERIFY(processAlive(pid));
+
+    a.cancelAll();
+    QVERIFY(f.isCanceled());
+    QTRY_VERIFY_WITH_TIMEOUT(!processAlive(pid), 5000);
+}
+
+void TestNetshWlanAsync::deadlineKillsCommand()
+{
+    NetshWlanReader::setBackend(nullptr);
+    NetshWlanAsync a;
+    if (!useSleepingShell(a)) QSKIP("needs /bin/sh");
+
+    QFuture<NetshReply<WifiInfo>> f = a.queryWifi(500);
+    QTRY_VERIFY(readPid() > 0);
+    const qint64 pid = readPid();
+
+    QTRY_VERIFY_WITH_TIMEOUT(f.isFinished(), 5000);
+    QVERIFY(f.result().timedOut);
+    QTRY_VERIFY_WITH_TIMEOUT(!processAlive(pid), 5000);
+}
+
+QTEST_GUILESS_MAIN(TestNetshWlanAsync)
+
+#include "tst_netshwlanasync.moc"
@@ -0,0 +1,9 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase console
+CONFIG -= app_bundle
+TARGET = tst_spectrumdecimator
+
+INCLUDEPATH += ../..
+SOURCES += tst_spectrumdecimator.cpp \
+           ../../CSpectrumDecimator.cpp
@@ -0,0 +1,64 @@
+#include <QtTest>
+#include "CSpectrumDecimator.h"
+
+class TestSpectrumDecimator : public QObject
+{
+    Q_OBJECT
+private slots:
+    void zoomedInMapping_data();
+    void zoomedInMapping();
+    void repeatsSameBin();
+};
+
+void TestSpectrumDecimator::zoomedInMapping_data()
+{
+    QTest::addColumn<int>("bins");
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("axis");
+
+    QTest::newRow("linear 100/800")  << 100  << 800  << int(CSpectrumDecimator::AXIS_LINEAR);
+    QTest::newRow("log 100/800")     << 100  << 800  << int(CSpectrumDecimator::AXIS_LOG);
+    QTest::newRow("linear 513/1920") << 513  << 1920 << int(CSpectrumDecimator::AXIS_LINEAR);
+    QTest::newRow("log 513/1920")    << 513  << 1920 << int(CSpectrumDecimator::AXIS_LOG);
+    QTest::newRow("log 1024/300")    << 1024 << 300  << int(CSpectrumDecimator::AXIS_LOG);
+    QTest::newRow("log 2/5")         << 2    << 5    << int(CSpectrumDecimator::AXIS_LOG);
+}
+
+// 像素比谱线多时：起始谱线不回退、始终在谱线范围内
+void TestSpectrumDecimator::zoomedInMapping()
+{
+    QFETCH(int, bins);
+    QFETCH(int, width);
+    QFETCH(int, axis);
+
+    CSpectrumDecimator d;
+    d.Setup(bins, width, axis);
+    const int *b = d.GetPixelBegin();
+    const int *e = d.GetPixelEnd();
+    const int first = (axis == CSpectrumDecimator::AXIS_LOG) ? 1 : 0;
+    for (int p = 0; p < width; p++) {
+        QVERIFY2(b[p] >= first && b[p] < bins, qPrintable(QString("pixel %1 begin %2").arg(p).arg(b[p])));
+        QVERIFY2(e[p] > b[p] && e[p] <= bins, qPrintable(QString("pixel %1 end %2").arg(p).arg(e[p])));
+        if (p > 0)
+            QVERIFY2(b[p] >= b[p - 1], qPrintable(QString("pixel %1 begin %2 < %3").arg(p).arg(b[p]).arg(b[p - 1])));
+    }
+    QCOMPARE(e[width - 1], bins);
+}
+
+// 放大时相邻像素重复 floor(起点) 那条谱线
+void TestSpectrumDecimator::repeatsSameBin()
+{
+    CSpectrumDecimator lin;
+    lin.Setup(100, 800, CSpectrumDecimator::AXIS_LINEAR);
+    QCOMPARE(lin.GetPixelBegin()[100], 12);   // 100 * 100 / 800 = 12.5
+    QCOMPARE(lin.GetPixelEnd()[100], 13);
+    QCOMPARE(lin.GetPixelBegin()[101], 12);
+
+    CSpectrumDecimator lg;
+    lg.Setup(100, 800, CSpectrumDecimator::AXIS_LOG);
+    QCOMPARE(lg.GetPixelBegin()[29], 1);      // exp(ln(100) * 29 / 800) ≈ 1.18
+    QCOMPARE(lg.GetPixelEnd()[29], 2);
+}
+
+QTEST_APPLESS_MAIN(TestSpectrumDecimator)
+#include "tst_spectrumdecimator.moc"
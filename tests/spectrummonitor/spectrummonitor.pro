@@ -0,0 +1,14 @@
+QT += testlib concurrent
+QT -= gui
+CONFIG += testcase console
+CONFIG -= app_bundle
+TARGET = tst_spectrummonitor
+
+INCLUDEPATH += ../..
+SOURCES += tst_spectrummonitor.cpp \
+           ../../CFftAlg.cpp \
+           ../../CFftPlan.cpp
+# 只有头文件的 Q_OBJECT 类要列在 HEADERS 里才会跑 moc
+HEADERS += ../../SpectrumMonitor.h \
+           ../../CFftAsync.h \
+           ../../MultiMsTicker.h
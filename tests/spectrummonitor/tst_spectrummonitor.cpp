@@ -0,0 +1,108 @@
+#include <QtTest>
+#include <QElapsedTimer>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QVector>
+#include <atomic>
+#include <cmath>
+#include "SpectrumMonitor.h"
+
+class TestSpectrumMonitor : public QObject
+{
+    Q_OBJECT
+private slots:
+    void peakIsPerFrame();
+    void lateTickLatencyFromSchedule();
+
+private:
+    static QVector<float> tone(int n, int bin, float amplitude, float offset = 0.0f);
+};
+
+QVector<float> TestSpectrumMonitor::tone(int n, int bin, float amplitude, float offset)
+{
+    QVector<float> v(n);
+    for (int i = 0; i < n; ++i) v[i] = offset + amplitude * float(std::sin(2.0 * PI * bin * i / n));
+    return v;
+}
+
+// 通道复用同一个 CFftAlg：第二帧的峰比第一帧小，freqMax 也只看第二帧
+void TestSpectrumMonitor::peakIsPerFrame()
+{
+    const int n = 256;
+    const float rate = 16000.0f; // 一个频点 62.5Hz
+    const QVector<float> loud = tone(n, 16, 4.0f);
+    const QVector<float> quiet = tone(n, 40, 1.0f);
+
+    CFftAlg reused;
+    QCOMPARE(CFftAsync::compute(reused, loud.constData(), n, rate, 1).freqMax, 1000.0f);
+    QCOMPARE(CFftAsync::compute(reused, quiet.constData(), n, rate, 2).freqMax, 2500.0f);
+
+    CFftAlg fresh;
+    QCOMPARE(CFftAsync::compute(fresh, quiet.constData(), n, rate, 3).freqMax, 2500.0f);
+
+    // 直流分量最大时就是 0Hz
+    const QVector<float> offset = tone(n, 40, 0.2f, 0.5f);
+    QVERIFY(qFuzzyIsNull(CFftAsync::compute(reused, offset.constData(), n, rate, 4).freqMax));
+}
+
+// 故意让调度线程卡住一段，盖过通道 2 的到点时刻：
+// - 通道 1（1ms）的第一次分析卡在 spectrumReady 里（工作线程），之后每次到点都 dropped；
+//   analysisDropped 直连在调度线程上，150ms 之后的第一次在槽里睡 120ms，再放开通道 1
+// - 通道 2（200ms）的 200ms 那一拍要等到调度线程醒来（约 270ms）才触发，
+//   它的耗时从节拍时刻算，至少包含这 70ms；通道 1 卡住期间的 100 多拍记作 missedTicks
+void TestSpectrumMonitor::lateTickLatencyFromSchedule()
+{
+    QThreadPool pool;
+    pool.setMaxThreadCount(2); // 一个给卡住的通道 1，一个给通道 2
+    QSemaphore gate;
+    std::atomic<bool> stalled{false};
+    QElapsedTimer clock;
+
+    SpectrumMonitor m;
+    m.setThreadPool(&pool);
+    SpectrumMonitor::ChannelConfig c;
+    c.intervalMs = 1;
+    c.frameLen = 64;
+    m.setChannel(1, c);
+    c.intervalMs = 200;
+    c.frameLen = 256;
+    m.setChannel(2, c);
+
+    QVector<float> samples(1024);
+    for (int i = 0; i < samples.size(); ++i) samples[i] = float(std::sin(i * 0.3));
+    m.pushSamples(1, samples);
+    m.pushSamples(2, samples);
+
+    connect(&m, &SpectrumMonitor::spectrumReady, &m, [&gate](int id, const FftSpectrum &) {
+        if (id != 1) return;
+        gate.acquire();
+        gate.release();
+    }, Qt::DirectConnection);
+    connect(&m, &SpectrumMonitor::analysisDropped, &m, [&](int id) {
+        if (id != 1 || stalled || clock.elapsed() < 150) return;
+        stalled = true;
+        QThread::msleep(120);
+        gate.release();
+    }, Qt::DirectConnection);
+
+    clock.start();
+    m.start();
+    QThread::msleep(600);
+    m.stop();
+    if (!stalled) gate.release(); // 没卡成也要放开，析构要等工作线程
+    QVERIFY(stalled);
+
+    const SpectrumMonitor::ChannelStats ch2 = m.channelStats(2);
+    QVERIFY(ch2.analyses >= 1);
+    const TickerStats::Snapshot latency = m.latencyStats();
+    QVERIFY2(latency.maxNs >= 40000000LL, qPrintable(QString::number(latency.maxNs)));
+
+    const SpectrumMonitor::ChannelStats ch1 = m.channelStats(1);
+    QVERIFY(ch1.dropped > 0);
+    QVERIFY2(ch1.missedTicks >= 50, qPrintable(QString::number(ch1.missedTicks)));
+    QCOMPARE(latency.missedTicks, ch1.missedTicks + ch2.missedTicks);
+}
+
+QTEST_GUILESS_MAIN(TestSpectrumMonitor)
+
+#include "tst_spectrummonitor.moc"
@@ -0,0 +1,7 @@
+TEMPLATE = subdirs
+SUBDIRS += spectrumdecimator \
+           wlanbackend \
+           netshoutputparser \
+           cmdsession \
+           netshwlanasync \
+           spectrummonitor
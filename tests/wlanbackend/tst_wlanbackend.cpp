@@ -0,0 +1,223 @@
+#include <QtTest>
+#include <QFile>
+#include <QHash>
+#include "WlanBackend.h"
+
+// 文件部分读夹具目录，ioctl / getifaddrs 两部分换成固定值
+class FixtureBackend : public LinuxWlanBackend
+{
+public:
+    FixtureBackend(const QString &interfaceName, const Paths &paths)
+        : LinuxWlanBackend(interfaceName, paths)
+    {
+    }
+
+    void setLink(const QString &iface, const QString &ssid, const QString &bssid, int bitrateMbps)
+    {
+        LinkInfo link;
+        link.ssid = ssid;
+        link.bssid = bssid;
+        link.bitrateMbps = bitrateMbps;
+        m_links.insert(iface, link);
+    }
+    void setIpv4(const QString &iface, const QString &ip) { m_ips.insert(iface, ip); }
+
+protected:
+    bool readLink(const QString &iface, LinkInfo &link) override
+    {
+        if (!m_links.contains(iface)) return false;
+        link = m_links.value(iface);
+        return true;
+    }
+    QString readIpv4(const QString &iface) override { return m_ips.value(iface); }
+
+private:
+    QHash<QString, LinkInfo> m_links;
+    QHash<QString, QString> m_ips;
+};
+
+class TestWlanBackend : public QObject
+{
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    void parseWireless();
+    void parseRouteGateway_data();
+    void parseRouteGateway();
+    void qualityToPercent_data();
+    void qualityToPercent();
+
+    void autoPicksLinkedInterface();
+    void namedDisconnectedInterface();
+    void missingInterface();
+    void noWirelessInterfaces();
+    void queryIp();
+
+private:
+    static QString fixture(const QString &relPath);
+    LinuxWlanBackend::Paths fixturePaths() const;
+
+    QString m_root;
+};
+
+void TestWlanBackend::initTestCase()
+{
+    m_root = QFINDTESTDATA("fixtures");
+    QVERIFY(!m_root.isEmpty());
+}
+
+QString TestWlanBackend::fixture(const QString &relPath)
+{
+    QFile f(QFINDTESTDATA("fixtures/" + relPath));
+    if (!f.open(QIODevice::ReadOnly)) return QString();
+    return QString::fromUtf8(f.readAll());
+}
+
+LinuxWlanBackend::Paths TestWlanBackend::fixturePaths() const
+{
+    LinuxWlanBackend::Paths paths;
+    paths.procRoot = m_root + "/proc";
+    paths.sysRoot = m_root + "/sys";
+    return paths;
+}
+
+// 两行表头跳过；数值后面表示“已更新”的 '.' 去掉
+void TestWlanBackend::parseWireless()
+{
+    const QList<LinuxWlanBackend::WirelessEntry> list =
+        LinuxWlanBackend::parseProcWireless(fixture("proc/net/wireless"));
+    QCOMPARE(list.size(), 2);
+
+    QCOMPARE(list.at(0).iface, QString("wlan1"));
+    QCOMPARE(list.at(0).link, 0);
+    QCOMPARE(list.at(0).level, -256);
+
+    QCOMPARE(list.at(1).iface, QString("wlp2s0"));
+    QCOMPARE(list.at(1).link, 54);
+    QCOMPARE(list.at(1).level, -56);
+}
+
+void TestWlanBackend::parseRouteGateway_data()
+{
+    QTest::addColumn<QString>("iface");
+    QTest::addColumn<QString>("gateway");
+
+    // 三条默认路由：metric 10 的没有网关标志，100 和 600 里取 100
+    QTest::newRow("smallest metric wins") << "wlp2s0" << "192.168.1.254";
+    QTest::newRow("other interface")      << "eth0"   << "10.0.0.1";
+    QTest::newRow("no gateway route")     << "wlan1"  << "";
+    QTest::newRow("unknown interface")    << "wlan9"  << "";
+}
+
+void TestWlanBackend::parseRouteGateway()
+{
+    // 夹具里的地址是按小端机器上 /proc 的样子写的
+    if (QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+        QSKIP("route fixture is little-endian");
+
+    QFETCH(QString, iface);
+    QFETCH(QString, gateway);
+    QCOMPARE(LinuxWlanBackend::parseProcRouteGateway(fixture("proc/net/route"), iface), gateway);
+}
+
+void TestWlanBackend::qualityToPercent_data()
+{
+    QTest::addColumn<int>("link");
+    QTest::addColumn<int>("percent");
+
+    QTest::newRow("zero")     << 0  << 0;
+    QTest::newRow("half")     << 35 << 50;
+    QTest::newRow("full")     << 70 << 100;
+    QTest::newRow("over")     << 94 << 100;
+    QTest::newRow("negative") << -5 << 0;
+}
+
+void TestWlanBackend::qualityToPercent()
+{
+    QFETCH(int, link);
+    QFETCH(int, percent);
+    QCOMPARE(LinuxWlanBackend::qualityToPercent(link), percent);
+}
+
+// 不指定网卡：跳过排在前面但没有链路质量的 wlan1
+void TestWlanBackend::autoPicksLinkedInterface()
+{
+    FixtureBackend backend(QString(), fixturePaths());
+    backend.setLink("wlp2s0", "AMNet_VPN_5G", "c4:70:ab:20:81:df", 866);
+
+    WifiInfo info;
+    QString err;
+    QVERIFY2(backend.queryWifi(info, &err), qPrintable(err));
+    QCOMPARE(info.interfaceName, QString("wlp2s0"));
+    QCOMPARE(info.interfaceDesc, QString("iwlwifi"));
+    QCOMPARE(info.mac, QString("90:09:df:51:20:b1"));
+    QCOMPARE(info.ssid, QString("AMNet_VPN_5G"));
+    QCOMPARE(info.bssid, QString("c4:70:ab:20:81:df"));
+    QVERIFY(info.connected);
+    QCOMPARE(info.state, QString("connected"));
+    QCOMPARE(info.signalPct, 77);
+    QCOMPARE(info.txRateMbps, 866);
+    QCOMPARE(info.rxRateMbps, -1);
+}
+
+void TestWlanBackend::namedDisconnectedInterface()
+{
+    FixtureBackend backend("wlan1", fixturePaths());
+
+    WifiInfo info;
+    QString err;
+    QVERIFY2(backend.queryWifi(info, &err), qPrintable(err));
+    QCOMPARE(info.interfaceName, QString("wlan1"));
+    QCOMPARE(info.mac, QString("02:00:00:00:01:00"));
+    QVERIFY(info.interfaceDesc.isEmpty());
+    QVERIFY(!info.connected);
+    QCOMPARE(info.state, QString("down"));
+    QCOMPARE(info.signalPct, -1);
+}
+
+void TestWlanBackend::missingInterface()
+{
+    FixtureBackend backend("wlan9", fixturePaths());
+
+    WifiInfo info;
+    QString err;
+    QVERIFY(!backend.queryWifi(info, &err));
+    QVERIFY2(err.contains("wlan9"), qPrintable(err));
+}
+
+void TestWlanBackend::noWirelessInterfaces()
+{
+    LinuxWlanBackend::Paths paths = fixturePaths();
+    paths.procRoot = m_root + "/missing";
+    FixtureBackend backend(QString(), paths);
+
+    WifiInfo info;
+    QString err;
+    QVERIFY(!backend.queryWifi(info, &err));
+    QVERIFY(!err.isEmpty());
+}
+
+void TestWlanBackend::queryIp()
+{
+    if (QSysInfo::ByteOrder != QSysInfo::LittleEndian)
+        QSKIP("route fixture is little-endian");
+
+    FixtureBackend backend(QString(), fixturePaths());
+    backend.setIpv4("wlp2s0", "192.168.1.23");
+
+    WifiInfo io;
+    QString err;
+    QVERIFY2(backend.queryIpForInterface("wlp2s0", io, &err), qPrintable(err));
+    QCOMPARE(io.ipv4, QString("192.168.1.23"));
+    QCOMPARE(io.gateway, QString("192.168.1.254"));
+
+    // 没有地址也没有网关
+    WifiInfo none;
+    QVERIFY(!backend.queryIpForInterface("wlan1", none, &err));
+    QVERIFY(!backend.queryIpForInterface(" ", none, &err));
+}
+
+QTEST_APPLESS_MAIN(TestWlanBackend)
+
+#include "tst_wlanbackend.moc"
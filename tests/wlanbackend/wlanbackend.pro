@@ -0,0 +1,9 @@
+QT += testlib
+QT -= gui
+CONFIG += testcase console
+CONFIG -= app_bundle
+TARGET = tst_wlanbackend
+
+INCLUDEPATH += ../..
+SOURCES += tst_wlanbackend.cpp \
+           ../../WlanBackend.cpp